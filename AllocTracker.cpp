@@ -0,0 +1,95 @@
+#include "AllocTracker.h"
+
+#ifdef LUDO_ALLOC_TRACKING
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace {
+    std::atomic<uint64_t> totalAllocations{0};
+    std::atomic<uint64_t> totalFrees{0};
+    std::atomic<uint64_t> totalBytes{0};
+
+    // Plain zero-initialised POD, so it is usable from operator new before and during
+    // thread start-up without a TLS guard
+    thread_local AllocTracker::Counts threadCounts;
+
+    void* track(void* p, std::size_t size) {
+        if (p) {
+            threadCounts.allocations++;
+            threadCounts.bytes += size;
+            totalAllocations.fetch_add(1, std::memory_order_relaxed);
+            totalBytes.fetch_add(size, std::memory_order_relaxed);
+        }
+        return p;
+    }
+
+    void untrack(void* p) {
+        if (!p) return;
+        threadCounts.frees++;
+        totalFrees.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void* allocate(std::size_t size) {
+        return track(std::malloc(size ? size : 1), size);
+    }
+
+    void* allocate(std::size_t size, std::align_val_t align) {
+        const std::size_t a = static_cast<std::size_t>(align);
+        // aligned_alloc wants a non-zero multiple of the alignment
+        const std::size_t rounded = size ? (size + a - 1) / a * a : a;
+        return track(std::aligned_alloc(a, rounded), size);
+    }
+}
+
+AllocTracker::Counts AllocTracker::process() {
+    return {totalAllocations.load(std::memory_order_relaxed), totalFrees.load(std::memory_order_relaxed),
+            totalBytes.load(std::memory_order_relaxed)};
+}
+
+AllocTracker::Counts AllocTracker::thread() {
+    return threadCounts;
+}
+
+void* operator new(std::size_t size) {
+    if (void* p = allocate(size)) return p;
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size) {
+    if (void* p = allocate(size)) return p;
+    throw std::bad_alloc();
+}
+
+void* operator new(std::size_t size, std::align_val_t align) {
+    if (void* p = allocate(size, align)) return p;
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size, std::align_val_t align) {
+    if (void* p = allocate(size, align)) return p;
+    throw std::bad_alloc();
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept { return allocate(size); }
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept { return allocate(size); }
+void* operator new(std::size_t size, std::align_val_t align, const std::nothrow_t&) noexcept {
+    return allocate(size, align);
+}
+void* operator new[](std::size_t size, std::align_val_t align, const std::nothrow_t&) noexcept {
+    return allocate(size, align);
+}
+
+void operator delete(void* p) noexcept { untrack(p); std::free(p); }
+void operator delete[](void* p) noexcept { untrack(p); std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { untrack(p); std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { untrack(p); std::free(p); }
+void operator delete(void* p, std::align_val_t) noexcept { untrack(p); std::free(p); }
+void operator delete[](void* p, std::align_val_t) noexcept { untrack(p); std::free(p); }
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept { untrack(p); std::free(p); }
+void operator delete[](void* p, std::size_t, std::align_val_t) noexcept { untrack(p); std::free(p); }
+void operator delete(void* p, const std::nothrow_t&) noexcept { untrack(p); std::free(p); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept { untrack(p); std::free(p); }
+void operator delete(void* p, std::align_val_t, const std::nothrow_t&) noexcept { untrack(p); std::free(p); }
+void operator delete[](void* p, std::align_val_t, const std::nothrow_t&) noexcept { untrack(p); std::free(p); }
+#endif
@@ -0,0 +1,33 @@
+#ifndef LUDO_GAME_ALLOCTRACKER_H
+#define LUDO_GAME_ALLOCTRACKER_H
+
+#include <cstdint>
+
+// Heap allocation counts from replaced global operator new/delete. Opt-in at build time
+// (cmake -DLUDO_ALLOC_TRACKING=ON): without it the replacements are not compiled and every
+// count reads zero. Counts are kept per thread, so a request handler can measure its own
+// allocations while other threads run, and process-wide for multi-threaded scenarios.
+class AllocTracker {
+public:
+    struct Counts {
+        uint64_t allocations = 0;
+        uint64_t frees = 0;
+        uint64_t bytes = 0; // Requested bytes, not allocator overhead
+
+        Counts operator-(const Counts& o) const {
+            return {allocations - o.allocations, frees - o.frees, bytes - o.bytes};
+        }
+    };
+
+#ifdef LUDO_ALLOC_TRACKING
+    static constexpr bool enabled = true;
+    static Counts process();
+    static Counts thread();
+#else
+    static constexpr bool enabled = false;
+    static Counts process() { return {}; }
+    static Counts thread() { return {}; }
+#endif
+};
+
+#endif //LUDO_GAME_ALLOCTRACKER_H
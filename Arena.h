@@ -0,0 +1,55 @@
+#ifndef LUDO_GAME_ARENA_H
+#define LUDO_GAME_ARENA_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+
+// Fixed-capacity bump allocator. Allocation is a single atomic add, so one arena can be
+// shared by several threads; nothing is freed individually, reset() drops everything.
+// Only trivially destructible objects belong here since destructors never run.
+class Arena {
+public:
+    explicit Arena(size_t capacityBytes)
+        : buffer(new std::byte[capacityBytes]), capacity(capacityBytes) {}
+
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+
+    static constexpr size_t ALIGNMENT = alignof(std::max_align_t);
+
+    // nullptr once the arena is exhausted
+    void* allocate(size_t bytes) {
+        size_t padded = (bytes + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+        size_t offset = used.fetch_add(padded, std::memory_order_relaxed);
+        if (offset + padded > capacity) return nullptr;
+        return buffer.get() + offset;
+    }
+
+    // Construct `count` default-initialised objects, or nullptr if out of space
+    template <class T>
+    T* makeArray(size_t count) {
+        static_assert(alignof(T) <= ALIGNMENT, "Arena does not over-align");
+        void* mem = allocate(sizeof(T) * count);
+        if (!mem) return nullptr;
+        T* items = static_cast<T*>(mem);
+        for (size_t i = 0; i < count; i++) new (items + i) T();
+        return items;
+    }
+
+    // Not thread-safe: call between searches only
+    void reset() { used.store(0, std::memory_order_relaxed); }
+
+    size_t bytesUsed() const { return std::min(used.load(std::memory_order_relaxed), capacity); }
+    size_t bytesCapacity() const { return capacity; }
+
+private:
+    std::unique_ptr<std::byte[]> buffer;
+    size_t capacity;
+    std::atomic<size_t> used{0};
+};
+
+#endif //LUDO_GAME_ARENA_H
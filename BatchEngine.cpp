@@ -0,0 +1,460 @@
+#include "BatchEngine.h"
+#include "Bitboard.h"
+#include "Random.h"
+#include <array>
+#include <bit>
+#include <type_traits>
+
+// Define LUDO_BATCH_SCALAR to force the portable kernels, e.g. to diff them against SIMD
+#if !defined(LUDO_BATCH_SCALAR) && (defined(__SSE2__) || defined(_M_X64))
+#include <emmintrin.h>
+#define LUDO_BATCH_SSE 1
+#if defined(__SSE4_1__)
+#include <smmintrin.h>
+#endif
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define LUDO_BATCH_AVX2 1
+#endif
+#endif
+
+namespace Ludo {
+    namespace {
+        // Safe squares as global track indices; must match SAFE_SQUARES in Bitboard.h
+        constexpr std::array<int8_t, 8> SAFE_INDICES = {0, 8, 13, 21, 26, 34, 39, 46};
+
+        constexpr bool matchesSafeMask() {
+            Bitboard mask = 0;
+            for (int8_t sq : SAFE_INDICES) mask |= squareBit(sq);
+            return mask == SAFE_SQUARES;
+        }
+        static_assert(matchesSafeMask(), "SAFE_INDICES out of sync with SAFE_SQUARES");
+
+        // Signed int8 lanes; comparisons yield all-ones (-1) for true, 0 for false.
+        struct Scalar {
+            static constexpr int WIDTH = 16;
+            std::array<int8_t, WIDTH> v;
+
+            template <class F>
+            static Scalar map(Scalar a, Scalar b, F f) {
+                Scalar r;
+                for (int i = 0; i < WIDTH; i++) r.v[i] = static_cast<int8_t>(f(a.v[i], b.v[i]));
+                return r;
+            }
+            static Scalar load(const int8_t* p) { Scalar r; for (int i = 0; i < WIDTH; i++) r.v[i] = p[i]; return r; }
+            void store(int8_t* p) const { for (int i = 0; i < WIDTH; i++) p[i] = v[i]; }
+            static Scalar set1(int8_t x) { Scalar r; r.v.fill(x); return r; }
+            friend Scalar operator+(Scalar a, Scalar b) { return map(a, b, [](int x, int y) { return x + y; }); }
+            friend Scalar operator-(Scalar a, Scalar b) { return map(a, b, [](int x, int y) { return x - y; }); }
+            friend Scalar operator&(Scalar a, Scalar b) { return map(a, b, [](int x, int y) { return x & y; }); }
+            friend Scalar operator|(Scalar a, Scalar b) { return map(a, b, [](int x, int y) { return x | y; }); }
+            static Scalar eq(Scalar a, Scalar b) { return map(a, b, [](int x, int y) { return x == y ? -1 : 0; }); }
+            static Scalar gt(Scalar a, Scalar b) { return map(a, b, [](int x, int y) { return x > y ? -1 : 0; }); }
+            static Scalar andNot(Scalar a, Scalar b) { return map(a, b, [](int x, int y) { return ~x & y; }); }
+            static Scalar min(Scalar a, Scalar b) { return map(a, b, [](int x, int y) { return x < y ? x : y; }); }
+            static Scalar select(Scalar m, Scalar a, Scalar b) {
+                Scalar r;
+                for (int i = 0; i < WIDTH; i++) r.v[i] = m.v[i] ? a.v[i] : b.v[i];
+                return r;
+            }
+            static uint64_t bits(Scalar m) {
+                uint64_t r = 0;
+                for (int i = 0; i < WIDTH; i++) r |= uint64_t(m.v[i] < 0) << i;
+                return r;
+            }
+        };
+
+#ifdef LUDO_BATCH_SSE
+        struct Sse {
+            static constexpr int WIDTH = 16;
+            __m128i v;
+
+            static Sse load(const int8_t* p) { return {_mm_loadu_si128(reinterpret_cast<const __m128i*>(p))}; }
+            void store(int8_t* p) const { _mm_storeu_si128(reinterpret_cast<__m128i*>(p), v); }
+            static Sse set1(int8_t x) { return {_mm_set1_epi8(x)}; }
+            friend Sse operator+(Sse a, Sse b) { return {_mm_add_epi8(a.v, b.v)}; }
+            friend Sse operator-(Sse a, Sse b) { return {_mm_sub_epi8(a.v, b.v)}; }
+            friend Sse operator&(Sse a, Sse b) { return {_mm_and_si128(a.v, b.v)}; }
+            friend Sse operator|(Sse a, Sse b) { return {_mm_or_si128(a.v, b.v)}; }
+            static Sse eq(Sse a, Sse b) { return {_mm_cmpeq_epi8(a.v, b.v)}; }
+            static Sse gt(Sse a, Sse b) { return {_mm_cmpgt_epi8(a.v, b.v)}; }
+            static Sse andNot(Sse a, Sse b) { return {_mm_andnot_si128(a.v, b.v)}; }
+            static Sse select(Sse m, Sse a, Sse b) {
+#ifdef __SSE4_1__
+                return {_mm_blendv_epi8(b.v, a.v, m.v)};
+#else
+                return {_mm_or_si128(_mm_and_si128(m.v, a.v), _mm_andnot_si128(m.v, b.v))};
+#endif
+            }
+            static Sse min(Sse a, Sse b) {
+#ifdef __SSE4_1__
+                return {_mm_min_epi8(a.v, b.v)};
+#else
+                return select(gt(a, b), b, a);
+#endif
+            }
+            static uint64_t bits(Sse m) { return static_cast<uint32_t>(_mm_movemask_epi8(m.v)); }
+        };
+#endif
+
+#ifdef LUDO_BATCH_AVX2
+        struct Avx2 {
+            static constexpr int WIDTH = 32;
+            __m256i v;
+
+            static Avx2 load(const int8_t* p) { return {_mm256_loadu_si256(reinterpret_cast<const __m256i*>(p))}; }
+            void store(int8_t* p) const { _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v); }
+            static Avx2 set1(int8_t x) { return {_mm256_set1_epi8(x)}; }
+            friend Avx2 operator+(Avx2 a, Avx2 b) { return {_mm256_add_epi8(a.v, b.v)}; }
+            friend Avx2 operator-(Avx2 a, Avx2 b) { return {_mm256_sub_epi8(a.v, b.v)}; }
+            friend Avx2 operator&(Avx2 a, Avx2 b) { return {_mm256_and_si256(a.v, b.v)}; }
+            friend Avx2 operator|(Avx2 a, Avx2 b) { return {_mm256_or_si256(a.v, b.v)}; }
+            static Avx2 eq(Avx2 a, Avx2 b) { return {_mm256_cmpeq_epi8(a.v, b.v)}; }
+            static Avx2 gt(Avx2 a, Avx2 b) { return {_mm256_cmpgt_epi8(a.v, b.v)}; }
+            static Avx2 andNot(Avx2 a, Avx2 b) { return {_mm256_andnot_si256(a.v, b.v)}; }
+            static Avx2 select(Avx2 m, Avx2 a, Avx2 b) { return {_mm256_blendv_epi8(b.v, a.v, m.v)}; }
+            static Avx2 min(Avx2 a, Avx2 b) { return {_mm256_min_epi8(a.v, b.v)}; }
+            static uint64_t bits(Avx2 m) { return static_cast<uint32_t>(_mm256_movemask_epi8(m.v)); }
+        };
+
+        template <int LANES>
+        using Vec = std::conditional_t<LANES % Avx2::WIDTH == 0, Avx2, Sse>;
+#elif defined(LUDO_BATCH_SSE)
+        template <int LANES>
+        using Vec = Sse;
+#else
+        template <int LANES>
+        using Vec = Scalar;
+#endif
+
+        // Global track index of a track progress for each lane's seat; P * 13 without a multiply
+        template <class V>
+        V toGlobal(V prog, V seat) {
+            const V s2 = seat + seat, s4 = s2 + s2, s8 = s4 + s4;
+            const V sq = prog + s8 + s4 + seat;
+            return V::select(V::gt(sq, V::set1(TRACK_SIZE - 1)), sq - V::set1(TRACK_SIZE), sq);
+        }
+
+        // Legal piece masks for the side to move, plus where each piece would land
+        template <class V>
+        void legalPieces(const V (&mine)[MAX_PIECES], V roll, V (&legal)[MAX_PIECES], V (&landing)[MAX_PIECES]) {
+            const V six = V::eq(roll, V::set1(6));
+            for (int i = 0; i < MAX_PIECES; i++) {
+                const V inBase = V::gt(V::set1(0), mine[i]);
+                landing[i] = V::select(inBase, V::set1(0), mine[i] + roll);
+                legal[i] = V::select(inBase, six, V::gt(V::set1(HOME_PROGRESS + 1), landing[i]));
+            }
+        }
+
+        template <class V, int LANES>
+        void gatherMover(const int8_t (&progress)[MAX_PLAYERS][MAX_PIECES][LANES], int o, V seat,
+                         int8_t numPlayers, V (&mine)[MAX_PIECES]) {
+            for (int i = 0; i < MAX_PIECES; i++) mine[i] = V::set1(-1);
+            for (int8_t s = 0; s < numPlayers; s++) {
+                const V isSeat = V::eq(seat, V::set1(s));
+                for (int i = 0; i < MAX_PIECES; i++) mine[i] = V::select(isSeat, V::load(progress[s][i] + o), mine[i]);
+            }
+        }
+
+        template <class V, int LANES>
+        int stepLanes(int8_t (&progress)[MAX_PLAYERS][MAX_PIECES][LANES], int8_t* current, int8_t* lastRoll,
+                      int8_t* winners, uint16_t* moveCount, int8_t numPlayers, const int8_t* rolls,
+                      const uint8_t* choices) {
+            int moves = 0;
+            for (int o = 0; o < LANES; o += V::WIDTH) {
+                const V seat = V::load(current + o);
+                const V roll = V::load(rolls + o);
+                const V winner = V::load(winners + o);
+                const V active = V::eq(winner, V::set1(-1));
+
+                V mine[MAX_PIECES], legal[MAX_PIECES], landing[MAX_PIECES];
+                gatherMover<V>(progress, o, seat, numPlayers, mine);
+                legalPieces<V>(mine, roll, legal, landing);
+
+                // Rank each piece by its distance after the lane's start piece; the legal piece
+                // with the lowest rank is played, 4 means nothing can move
+                const V start = V::load(reinterpret_cast<const int8_t*>(choices) + o) & V::set1(MAX_PIECES - 1);
+                V rank[MAX_PIECES];
+                V best = V::set1(MAX_PIECES);
+                for (int i = 0; i < MAX_PIECES; i++) {
+                    rank[i] = (V::set1(static_cast<int8_t>(i)) - start) & V::set1(MAX_PIECES - 1);
+                    best = V::min(best, V::select(legal[i], rank[i], V::set1(MAX_PIECES)));
+                }
+                const V moved = V::andNot(V::eq(best, V::set1(MAX_PIECES)), active);
+
+                V chosen[MAX_PIECES];
+                V target = V::set1(0);
+                V allHome = V::set1(-1);
+                for (int i = 0; i < MAX_PIECES; i++) {
+                    chosen[i] = moved & legal[i] & V::eq(rank[i], best);
+                    target = V::select(chosen[i], landing[i], target);
+                    allHome = allHome & V::eq(V::select(chosen[i], landing[i], mine[i]), V::set1(HOME_PROGRESS));
+                }
+                for (int8_t s = 0; s < numPlayers; s++) {
+                    const V isSeat = V::eq(seat, V::set1(s));
+                    for (int i = 0; i < MAX_PIECES; i++) {
+                        const V prog = V::load(progress[s][i] + o);
+                        V::select(isSeat & chosen[i], landing[i], prog).store(progress[s][i] + o);
+                    }
+                }
+
+                // Capture everything of other seats on an unsafe landing square
+                const V square = toGlobal(target, seat);
+                V safe = V::set1(0);
+                for (int8_t sq : SAFE_INDICES) safe = safe | V::eq(square, V::set1(sq));
+                const V captures = V::andNot(safe, moved & V::gt(V::set1(TRACK_SIZE), target));
+                for (int8_t s = 0; s < numPlayers; s++) {
+                    const V seatCaptures = V::andNot(V::eq(seat, V::set1(s)), captures);
+                    if (!V::bits(seatCaptures)) continue;
+                    for (int i = 0; i < MAX_PIECES; i++) {
+                        const V prog = V::load(progress[s][i] + o);
+                        const V onTrack = V::gt(prog, V::set1(-1)) & V::gt(V::set1(TRACK_SIZE), prog);
+                        const V hit = seatCaptures & onTrack & V::eq(toGlobal(prog, V::set1(s)), square);
+                        V::select(hit, V::set1(-1), prog).store(progress[s][i] + o);
+                    }
+                }
+
+                // Turn order: a win or a 6 keeps the seat, everything else passes it on
+                const V won = moved & allHome;
+                const V keep = (moved & V::eq(roll, V::set1(6))) | won;
+                V next = seat + V::set1(1);
+                next = V::select(V::eq(next, V::set1(numPlayers)), V::set1(0), next);
+                V::select(active, V::select(keep, seat, next), seat).store(current + o);
+                V::select(active, roll, V::load(lastRoll + o)).store(lastRoll + o);
+                V::select(won, seat, winner).store(winners + o);
+
+                for (uint64_t m = V::bits(moved); m; m &= m - 1) moveCount[o + std::countr_zero(m)]++;
+                moves += std::popcount(V::bits(moved));
+            }
+            return moves;
+        }
+
+        template <class V, int LANES>
+        void legalLanes(const int8_t (&progress)[MAX_PLAYERS][MAX_PIECES][LANES], const int8_t* current,
+                        int8_t numPlayers, const int8_t* rolls, uint8_t* masks) {
+            for (int o = 0; o < LANES; o += V::WIDTH) {
+                V mine[MAX_PIECES], legal[MAX_PIECES], landing[MAX_PIECES];
+                gatherMover<V>(progress, o, V::load(current + o), numPlayers, mine);
+                legalPieces<V>(mine, V::load(rolls + o), legal, landing);
+                V mask = V::set1(0);
+                for (int i = 0; i < MAX_PIECES; i++) mask = mask | (legal[i] & V::set1(static_cast<int8_t>(1 << i)));
+                mask.store(reinterpret_cast<int8_t*>(masks) + o);
+            }
+        }
+
+        constexpr uint32_t rotl(uint32_t x, int k) { return (x << k) | (x >> (32 - k)); }
+
+        // xoshiro128+ on every lane. The die comes from the top 16 bits by multiply-shift
+        // ((x * 6) >> 16, bias below 1e-4) and the choice from bits 14-15.
+        template <int LANES>
+        void diceScalar(uint32_t (&s)[4][LANES], int8_t* rolls, uint8_t* choices) {
+            for (int l = 0; l < LANES; l++) {
+                const uint32_t result = s[0][l] + s[3][l];
+                const uint32_t t = s[1][l] << 9;
+                s[2][l] ^= s[0][l];
+                s[3][l] ^= s[1][l];
+                s[1][l] ^= s[2][l];
+                s[0][l] ^= s[3][l];
+                s[2][l] ^= t;
+                s[3][l] = rotl(s[3][l], 11);
+                rolls[l] = static_cast<int8_t>((((result >> 16) * 6) >> 16) + 1);
+                choices[l] = static_cast<uint8_t>((result >> 14) & 3);
+            }
+        }
+
+#ifdef LUDO_BATCH_SSE
+        inline __m128i nextSse(uint32_t* s0, uint32_t* s1, uint32_t* s2, uint32_t* s3) {
+            __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s0));
+            __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s1));
+            __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s2));
+            __m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s3));
+            const __m128i result = _mm_add_epi32(a, d);
+            const __m128i t = _mm_slli_epi32(b, 9);
+            c = _mm_xor_si128(c, a);
+            d = _mm_xor_si128(d, b);
+            b = _mm_xor_si128(b, c);
+            a = _mm_xor_si128(a, d);
+            c = _mm_xor_si128(c, t);
+            d = _mm_or_si128(_mm_slli_epi32(d, 11), _mm_srli_epi32(d, 21));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(s0), a);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(s1), b);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(s2), c);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(s3), d);
+            return result;
+        }
+
+        template <int LANES>
+        void diceSse(uint32_t (&s)[4][LANES], int8_t* rolls, uint8_t* choices) {
+            // Multiplying only the high 16-bit half by 6 leaves the die in bits 16-31
+            const __m128i six = _mm_set1_epi32(6 << 16);
+            const __m128i one = _mm_set1_epi8(1);
+            for (int o = 0; o < LANES; o += 16) {
+                __m128i r[4], d[4], c[4];
+                for (int k = 0; k < 4; k++) {
+                    const int l = o + 4 * k;
+                    r[k] = nextSse(s[0] + l, s[1] + l, s[2] + l, s[3] + l);
+                    d[k] = _mm_srli_epi32(_mm_mulhi_epu16(r[k], six), 16);
+                    c[k] = _mm_and_si128(_mm_srli_epi32(r[k], 14), _mm_set1_epi32(3));
+                }
+                const __m128i die = _mm_packs_epi16(_mm_packs_epi32(d[0], d[1]), _mm_packs_epi32(d[2], d[3]));
+                const __m128i choice = _mm_packs_epi16(_mm_packs_epi32(c[0], c[1]), _mm_packs_epi32(c[2], c[3]));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(rolls + o), _mm_add_epi8(die, one));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(choices + o), choice);
+            }
+        }
+#endif
+
+#ifdef LUDO_BATCH_AVX2
+        inline __m256i nextAvx2(uint32_t* s0, uint32_t* s1, uint32_t* s2, uint32_t* s3) {
+            __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s0));
+            __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s1));
+            __m256i c = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s2));
+            __m256i d = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s3));
+            const __m256i result = _mm256_add_epi32(a, d);
+            const __m256i t = _mm256_slli_epi32(b, 9);
+            c = _mm256_xor_si256(c, a);
+            d = _mm256_xor_si256(d, b);
+            b = _mm256_xor_si256(b, c);
+            a = _mm256_xor_si256(a, d);
+            c = _mm256_xor_si256(c, t);
+            d = _mm256_or_si256(_mm256_slli_epi32(d, 11), _mm256_srli_epi32(d, 21));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(s0), a);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(s1), b);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(s2), c);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(s3), d);
+            return result;
+        }
+
+        template <int LANES>
+        void diceAvx2(uint32_t (&s)[4][LANES], int8_t* rolls, uint8_t* choices) {
+            const __m256i six = _mm256_set1_epi32(6 << 16);
+            const __m256i one = _mm256_set1_epi8(1);
+            // Packs work per 128-bit half; this puts the dwords back in lane order
+            const __m256i order = _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7);
+            for (int o = 0; o < LANES; o += 32) {
+                __m256i d[4], c[4];
+                for (int k = 0; k < 4; k++) {
+                    const int l = o + 8 * k;
+                    const __m256i r = nextAvx2(s[0] + l, s[1] + l, s[2] + l, s[3] + l);
+                    d[k] = _mm256_srli_epi32(_mm256_mulhi_epu16(r, six), 16);
+                    c[k] = _mm256_and_si256(_mm256_srli_epi32(r, 14), _mm256_set1_epi32(3));
+                }
+                __m256i die = _mm256_packs_epi16(_mm256_packs_epi32(d[0], d[1]), _mm256_packs_epi32(d[2], d[3]));
+                __m256i choice = _mm256_packs_epi16(_mm256_packs_epi32(c[0], c[1]), _mm256_packs_epi32(c[2], c[3]));
+                die = _mm256_permutevar8x32_epi32(die, order);
+                choice = _mm256_permutevar8x32_epi32(choice, order);
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(rolls + o), _mm256_add_epi8(die, one));
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(choices + o), choice);
+            }
+        }
+#endif
+    }
+
+    template <int LANES>
+    BatchEngine<LANES>::BatchEngine(int8_t numPlayers, uint64_t seed) : numPlayers(numPlayers) {
+        for (int l = 0; l < LANES; l++) {
+            const uint64_t a = splitmix64(seed), b = splitmix64(seed);
+            rng[0][l] = static_cast<uint32_t>(a);
+            rng[1][l] = static_cast<uint32_t>(a >> 32);
+            rng[2][l] = static_cast<uint32_t>(b);
+            rng[3][l] = static_cast<uint32_t>(b >> 32) | 1; // Never the all-zero state
+        }
+        resetAll();
+    }
+
+    template <int LANES>
+    void BatchEngine<LANES>::resetAll() {
+        for (int l = 0; l < LANES; l++) resetLane(l);
+    }
+
+    template <int LANES>
+    void BatchEngine<LANES>::resetLane(int lane) {
+        for (auto& seat : progress) {
+            for (auto& piece : seat) piece[lane] = -1;
+        }
+        current[lane] = 0;
+        lastRoll[lane] = 0;
+        winners[lane] = -1;
+        moveCount[lane] = 0;
+    }
+
+    template <int LANES>
+    void BatchEngine<LANES>::setLane(int lane, const GameState& state) {
+        for (int s = 0; s < MAX_PLAYERS; s++) {
+            for (int i = 0; i < MAX_PIECES; i++) progress[s][i][lane] = state.progress[s][i];
+        }
+        current[lane] = state.currentPlayer;
+        lastRoll[lane] = state.roll;
+        winners[lane] = state.winner;
+        moveCount[lane] = 0;
+    }
+
+    template <int LANES>
+    GameState BatchEngine<LANES>::lane(int lane) const {
+        GameState state = makeGameState(numPlayers);
+        for (int s = 0; s < MAX_PLAYERS; s++) {
+            for (int i = 0; i < MAX_PIECES; i++) state.progress[s][i] = progress[s][i][lane];
+        }
+        state.currentPlayer = current[lane];
+        state.roll = lastRoll[lane];
+        state.winner = winners[lane];
+        state.phase = state.winner >= 0 ? Phase::GAME_OVER : Phase::WAITING_FOR_ROLL;
+        state.hash = computeHash(state);
+        return state;
+    }
+
+    template <int LANES>
+    void BatchEngine<LANES>::rollDice(int8_t* rolls, uint8_t* choices) {
+#if defined(LUDO_BATCH_AVX2)
+        if constexpr (LANES % 32 == 0) diceAvx2<LANES>(rng, rolls, choices);
+        else diceSse<LANES>(rng, rolls, choices);
+#elif defined(LUDO_BATCH_SSE)
+        diceSse<LANES>(rng, rolls, choices);
+#else
+        diceScalar<LANES>(rng, rolls, choices);
+#endif
+    }
+
+    template <int LANES>
+    void BatchEngine<LANES>::legalMoves(const int8_t* rolls, uint8_t* masks) const {
+        legalLanes<Vec<LANES>, LANES>(progress, current, numPlayers, rolls, masks);
+    }
+
+    template <int LANES>
+    int BatchEngine<LANES>::step(const int8_t* rolls, const uint8_t* choices) {
+        return stepLanes<Vec<LANES>, LANES>(progress, current, lastRoll, winners, moveCount, numPlayers,
+                                                rolls, choices);
+    }
+
+    template <int LANES>
+    int BatchEngine<LANES>::step() {
+        alignas(64) int8_t rolls[LANES];
+        alignas(64) uint8_t choices[LANES];
+        rollDice(rolls, choices);
+        return step(rolls, choices);
+    }
+
+    template <int LANES>
+    int BatchEngine<LANES>::unfinishedLanes() const {
+        int count = 0;
+        for (int l = 0; l < LANES; l++) count += winners[l] < 0;
+        return count;
+    }
+
+    template <int LANES>
+    const char* BatchEngine<LANES>::isa() {
+#if defined(LUDO_BATCH_AVX2)
+        return LANES % 32 == 0 ? "avx2" : "sse4.1";
+#elif defined(LUDO_BATCH_SSE) && defined(__SSE4_1__)
+        return "sse4.1";
+#elif defined(LUDO_BATCH_SSE)
+        return "sse2";
+#else
+        return "scalar";
+#endif
+    }
+
+    template class BatchEngine<16>;
+    template class BatchEngine<32>;
+    template class BatchEngine<64>;
+}
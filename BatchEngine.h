@@ -0,0 +1,67 @@
+#ifndef LUDO_GAME_BATCHENGINE_H
+#define LUDO_GAME_BATCHENGINE_H
+
+#include <cstdint>
+#include "Constants.h"
+#include "GameState.h"
+
+namespace Ludo {
+    // Many independent games advanced in lockstep, stored structure-of-arrays: one int8 lane
+    // per game, so a single vector instruction touches the same piece in 16/32/64 games.
+    // Kernels are picked at compile time (AVX2, SSE4.1, SSE2, then plain C++); build with
+    // -DLUDO_NATIVE_ARCH=ON to let the compiler use everything the host supports.
+    //
+    // A step is one turn per lane: roll, pick a move, apply it with captures, pass or keep the
+    // turn. The move policy is fixed so it can be vectorised: among the legal pieces, take the
+    // first one at or after (choice % 4), wrapping around. Finished lanes are frozen.
+    template <int LANES>
+    class BatchEngine {
+    public:
+        static_assert(LANES == 16 || LANES == 32 || LANES == 64, "Lanes must be 16, 32 or 64");
+        static constexpr int lanes = LANES;
+
+        BatchEngine(int8_t numPlayers, uint64_t seed);
+
+        void resetAll();
+        void resetLane(int lane);
+
+        // Lane <-> scalar position, for seeding from and checking against GameState.
+        // setLane expects a position that is waiting for a roll (or over).
+        void setLane(int lane, const GameState& state);
+        GameState lane(int lane) const;
+
+        // Vectorised dice: one roll (1-6) and one policy choice byte per lane
+        void rollDice(int8_t* rolls, uint8_t* choices);
+
+        // Bit i of masks[lane] = the side to move may move piece i with rolls[lane]
+        void legalMoves(const int8_t* rolls, uint8_t* masks) const;
+
+        // Advance every unfinished lane by one turn; returns how many moves were made
+        int step(const int8_t* rolls, const uint8_t* choices);
+        int step();
+
+        bool finished(int lane) const { return winners[lane] >= 0; }
+        int8_t winner(int lane) const { return winners[lane]; }
+        int moves(int lane) const { return moveCount[lane]; }
+        int8_t players() const { return numPlayers; }
+        int unfinishedLanes() const;
+
+        // Instruction set the kernels were compiled for
+        static const char* isa();
+
+    private:
+        alignas(64) int8_t progress[MAX_PLAYERS][MAX_PIECES][LANES];
+        alignas(64) int8_t current[LANES];
+        alignas(64) int8_t lastRoll[LANES];
+        alignas(64) int8_t winners[LANES];
+        alignas(64) uint32_t rng[4][LANES]; // xoshiro128+ state, one generator per lane
+        uint16_t moveCount[LANES];
+        int8_t numPlayers;
+    };
+
+    extern template class BatchEngine<16>;
+    extern template class BatchEngine<32>;
+    extern template class BatchEngine<64>;
+}
+
+#endif //LUDO_GAME_BATCHENGINE_H
@@ -0,0 +1,43 @@
+#ifndef LUDO_GAME_BITBOARD_H
+#define LUDO_GAME_BITBOARD_H
+
+#include <cstdint>
+#include "Constants.h"
+
+namespace Ludo {
+    // One 64-bit mask per player.
+    // Bits 0-51:  global track squares (shared by every player).
+    // Bits 52-57: the owner's private home stretch and home (same index as progress).
+    using Bitboard = uint64_t;
+
+    constexpr Bitboard squareBit(int square) { return Bitboard{1} << square; }
+
+    constexpr Bitboard TRACK_SQUARES = squareBit(TRACK_SIZE) - 1;
+
+    // Safe squares by global track index: (6,1) (2,6) (1,8) (6,12) (8,13) (12,8) (13,6) (8,3)
+    constexpr Bitboard SAFE_SQUARES = squareBit(0) | squareBit(8) | squareBit(13) | squareBit(21) |
+                                      squareBit(26) | squareBit(34) | squareBit(39) | squareBit(46);
+
+    // Single shift-and-mask on the constant above; track index 0-51
+    constexpr bool isSafeTrackIndex(int square) { return (SAFE_SQUARES >> square) & 1; }
+
+    static_assert(isSafeTrackIndex(0) && isSafeTrackIndex(46) && !isSafeTrackIndex(1) && !isSafeTrackIndex(51));
+
+    // Global track index for a piece on the shared track (progress 0-51); a table lookup
+    constexpr int globalSquare(int playerIdx, int progress) { return trackIndex(playerIdx, progress); }
+
+    // Inverse of globalSquare: the progress at which `playerIdx` stands on track index `square`
+    constexpr int trackProgress(int playerIdx, int square) {
+        const int progress = square - playerIdx * START_OFFSET;
+        return progress < 0 ? progress + TRACK_SIZE : progress;
+    }
+
+    static_assert(trackProgress(1, globalSquare(1, 45)) == 45 && trackProgress(3, globalSquare(3, 2)) == 2);
+
+    // Bit index of a piece that is out of base (progress 0-57).
+    constexpr int squareOf(int playerIdx, int progress) {
+        return progress < TRACK_SIZE ? globalSquare(playerIdx, progress) : progress;
+    }
+}
+
+#endif //LUDO_GAME_BITBOARD_H
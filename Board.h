@@ -4,20 +4,20 @@
 #include <array>
 #include <cstdint>
 #include "Constants.h"
+#include "Bitboard.h"
 
 class Board {
 public:
     Board();
     
-    // Get coordinate for a player's piece based on their progress
+    // Get coordinate for a player's piece based on their progress (see PROGRESS_TO_COORD)
     static Ludo::Coord getCoord(int8_t playerId, int8_t progress);
     
-    // Check if a spot is safe
+    // Check if a spot is safe: cell -> track index -> SAFE_SQUARES bit, no search
     static bool isSafeSpot(int8_t r, int8_t c);
 
-private:
-    static const std::array<Ludo::Coord, Ludo::TRACK_SIZE> TRACK_PATH;
-    static const std::array<std::array<Ludo::Coord, Ludo::HOME_STRETCH_SIZE + 1>, Ludo::MAX_PLAYERS> HOME_STRETCHES;
+    // Same check by global track index (0-51), for callers that never had a coordinate
+    static constexpr bool isSafeTrackIndex(int square) { return Ludo::isSafeTrackIndex(square); }
 };
 
 #endif //LUDO_GAME_BOARD_H
@@ -8,4 +8,27 @@
 #include "Player.h"
 #include "Board.h"
 #include "Game.h"
+#include "Expectimax.h"
 
+namespace {
+    constexpr size_t SHARED_TABLE_MB = 64;
+}
+
+TranspositionTable& Computer::sharedTable() {
+    static TranspositionTable table(SHARED_TABLE_MB);
+    return table;
+}
+
+Ludo::Move Computer::chooseMove(const Ludo::GameState& state, int8_t roll, std::chrono::nanoseconds budget) {
+    Ludo::GameState position = state;
+    if (position.phase == Ludo::Phase::WAITING_FOR_ROLL) {
+        Ludo::applyRoll(position, roll);
+    }
+    if (position.phase != Ludo::Phase::WAITING_FOR_MOVE || position.roll != roll) {
+        return {-1, -1, -1, 0}; // Nothing can move with this roll
+    }
+
+    // One searcher per thread; they all share the lock-free table
+    thread_local Expectimax search(sharedTable());
+    return search.search(position, budget).move;
+}
@@ -2,8 +2,12 @@
 #define LUDO_GAME_COMPUTER_H
 
 #include <iostream>
+#include <chrono>
 #include "Player.h"
 #include "Board.h"
+#include "GameState.h"
+#include "MoveGen.h"
+#include "TranspositionTable.h"
 
 
 class Computer : public Player {
@@ -13,7 +17,12 @@ public:
         // Set other attributes as needed
     }
 
+    // Pick a move for the current player of `state` after rolling `roll`, using expectimax
+    // search within `budget`. Returns a Move with piece == -1 if the roll cannot be used.
+    static Ludo::Move chooseMove(const Ludo::GameState& state, int8_t roll, std::chrono::nanoseconds budget);
 
+    // Transposition table shared by every bot in the process
+    static TranspositionTable& sharedTable();
 };
 
-#endif //LUDO_GAME_COMPUTER_H
\ No newline at end of file
+#endif //LUDO_GAME_COMPUTER_H
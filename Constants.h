@@ -2,6 +2,7 @@
 #define LUDO_GAME_CONSTANTS_H
 
 #include <array>
+#include <cstdint>
 #include <utility>
 
 namespace Ludo {
@@ -10,17 +11,130 @@ namespace Ludo {
     constexpr int TOTAL_PROGRESS_STEPS = TRACK_SIZE + HOME_STRETCH_SIZE + 1; // 58 steps total
     constexpr int MAX_PIECES = 4;
     constexpr int MAX_PLAYERS = 4;
+    constexpr int START_OFFSET = TRACK_SIZE / MAX_PLAYERS; // 13 squares between start spots
+    constexpr int DIE_FACES = 6;
+
+    // Progress -1 (base) .. 57 (home), stored at index progress + 1 in every per-progress table
+    constexpr int PROGRESS_SLOTS = TOTAL_PROGRESS_STEPS + 1;
 
-    // Coordinate mapping for the 52 track squares
-    // We'll pre-fill this or use a helper. 
-    // For now, let's just define the structure for HFT-level speed.
     struct Coord {
         int8_t r;
         int8_t c;
+
+        constexpr bool operator==(const Coord&) const = default;
     };
 
-    // Fast mapping from progress to coordinates
-    extern const std::array<std::array<Coord, TOTAL_PROGRESS_STEPS>, MAX_PLAYERS> PROGRESS_TO_COORD;
+    // Track squares on the 15x15 grid, starting from Green's start position (6, 1)
+    constexpr std::array<Coord, TRACK_SIZE> TRACK_COORDS = {{
+        {6, 1}, {6, 2}, {6, 3}, {6, 4}, {6, 5},
+        {5, 6}, {4, 6}, {3, 6}, {2, 6}, {1, 6}, {0, 6},
+        {0, 7}, {0, 8},
+        {1, 8}, {2, 8}, {3, 8}, {4, 8}, {5, 8},
+        {6, 9}, {6, 10}, {6, 11}, {6, 12}, {6, 13}, {6, 14},
+        {7, 14}, {8, 14},
+        {8, 13}, {8, 12}, {8, 11}, {8, 10}, {8, 9},
+        {9, 8}, {10, 8}, {11, 8}, {12, 8}, {13, 8}, {14, 8},
+        {14, 7}, {14, 6},
+        {13, 6}, {12, 6}, {11, 6}, {10, 6}, {9, 6},
+        {8, 5}, {8, 4}, {8, 3}, {8, 2}, {8, 1}, {8, 0},
+        {7, 0}, {6, 0}
+    }};
+
+    // Home stretch per player; the last entry is home
+    constexpr std::array<std::array<Coord, HOME_STRETCH_SIZE + 1>, MAX_PLAYERS> HOME_STRETCH_COORDS = {{
+        // P0: Green
+        {{{7, 1}, {7, 2}, {7, 3}, {7, 4}, {7, 5}, {7, 6}}},
+        // P1: Red
+        {{{1, 7}, {2, 7}, {3, 7}, {4, 7}, {5, 7}, {6, 7}}},
+        // P2: Blue
+        {{{7, 13}, {7, 12}, {7, 11}, {7, 10}, {7, 9}, {7, 8}}},
+        // P3: Yellow
+        {{{13, 7}, {12, 7}, {11, 7}, {10, 7}, {9, 7}, {8, 7}}}
+    }};
+
+    using ProgressTable = std::array<std::array<int8_t, PROGRESS_SLOTS>, MAX_PLAYERS>;
+
+    // Global track index per player and progress; -1 off the shared track (base, home stretch)
+    constexpr ProgressTable makeProgressToTrack() {
+        ProgressTable table{};
+        for (int p = 0; p < MAX_PLAYERS; p++) {
+            for (int prog = -1; prog < TOTAL_PROGRESS_STEPS; prog++) {
+                table[p][prog + 1] = static_cast<int8_t>(
+                    prog >= 0 && prog < TRACK_SIZE ? (prog + p * START_OFFSET) % TRACK_SIZE : -1);
+            }
+        }
+        return table;
+    }
+
+    inline constexpr ProgressTable PROGRESS_TO_TRACK = makeProgressToTrack();
+
+    // Board coordinate per player and progress; a piece in base is drawn on its start square
+    constexpr std::array<std::array<Coord, PROGRESS_SLOTS>, MAX_PLAYERS> makeProgressToCoord() {
+        std::array<std::array<Coord, PROGRESS_SLOTS>, MAX_PLAYERS> table{};
+        for (int p = 0; p < MAX_PLAYERS; p++) {
+            table[p][0] = TRACK_COORDS[p * START_OFFSET];
+            for (int prog = 0; prog < TOTAL_PROGRESS_STEPS; prog++) {
+                table[p][prog + 1] = prog < TRACK_SIZE ? TRACK_COORDS[PROGRESS_TO_TRACK[p][prog + 1]]
+                                                       : HOME_STRETCH_COORDS[p][prog - TRACK_SIZE];
+            }
+        }
+        return table;
+    }
+
+    inline constexpr std::array<std::array<Coord, PROGRESS_SLOTS>, MAX_PLAYERS> PROGRESS_TO_COORD = makeProgressToCoord();
+
+    // Progress after moving with a roll, or -1 when the move is illegal: spawning needs a 6
+    // (and lands on 0), and home (57) must not be overshot. Index [progress + 1][roll].
+    constexpr std::array<std::array<int8_t, DIE_FACES + 1>, PROGRESS_SLOTS> makeNextProgress() {
+        std::array<std::array<int8_t, DIE_FACES + 1>, PROGRESS_SLOTS> table{};
+        for (int prog = -1; prog < TOTAL_PROGRESS_STEPS; prog++) {
+            table[prog + 1][0] = -1;
+            for (int roll = 1; roll <= DIE_FACES; roll++) {
+                int next = prog < 0 ? (roll == DIE_FACES ? 0 : -1) : prog + roll;
+                table[prog + 1][roll] = static_cast<int8_t>(next < TOTAL_PROGRESS_STEPS ? next : -1);
+            }
+        }
+        return table;
+    }
+
+    inline constexpr auto NEXT_PROGRESS = makeNextProgress();
+
+    // Track index of a board cell, -1 for cells off the track
+    constexpr int BOARD_SIZE = 15;
+
+    constexpr std::array<std::array<int8_t, BOARD_SIZE>, BOARD_SIZE> makeCoordToTrack() {
+        std::array<std::array<int8_t, BOARD_SIZE>, BOARD_SIZE> table{};
+        for (auto& row : table) row.fill(-1);
+        for (int i = 0; i < TRACK_SIZE; i++) table[TRACK_COORDS[i].r][TRACK_COORDS[i].c] = static_cast<int8_t>(i);
+        return table;
+    }
+
+    inline constexpr auto COORD_TO_TRACK = makeCoordToTrack();
+
+    constexpr int trackIndex(int playerIdx, int progress) { return PROGRESS_TO_TRACK[playerIdx][progress + 1]; }
+    constexpr Coord progressCoord(int playerIdx, int progress) { return PROGRESS_TO_COORD[playerIdx][progress + 1]; }
+    constexpr int nextProgress(int progress, int roll) { return NEXT_PROGRESS[progress + 1][roll]; }
+
+    constexpr bool trackIsConnected() {
+        for (int i = 0; i < TRACK_SIZE; i++) {
+            const Coord a = TRACK_COORDS[i], b = TRACK_COORDS[(i + 1) % TRACK_SIZE];
+            const int dr = a.r - b.r, dc = a.c - b.c;
+            if (dr * dr > 1 || dc * dc > 1 || (dr == 0 && dc == 0)) return false;
+            for (int j = 0; j < i; j++) {
+                if (TRACK_COORDS[j] == a) return false;
+            }
+        }
+        return true;
+    }
+
+    static_assert(trackIsConnected(), "Track squares must be distinct and adjacent in order");
+    static_assert(trackIndex(0, 0) == 0 && trackIndex(1, 0) == START_OFFSET && trackIndex(3, 51) == 38);
+    static_assert(trackIndex(2, -1) == -1 && trackIndex(2, TRACK_SIZE) == -1);
+    static_assert(progressCoord(0, -1) == Coord{6, 1} && progressCoord(1, 0) == Coord{1, 8});
+    static_assert(progressCoord(2, TOTAL_PROGRESS_STEPS - 1) == Coord{7, 8});
+    static_assert(nextProgress(-1, 6) == 0 && nextProgress(-1, 5) == -1);
+    static_assert(nextProgress(51, 6) == TOTAL_PROGRESS_STEPS - 1 && nextProgress(52, 6) == -1);
+    static_assert(nextProgress(TOTAL_PROGRESS_STEPS - 1, 1) == -1);
 }
 
 #endif //LUDO_GAME_CONSTANTS_H
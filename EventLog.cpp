@@ -0,0 +1,183 @@
+#include "EventLog.h"
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstdlib>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace {
+    // Single producer (the owning thread), single consumer (the drain thread)
+    struct Ring {
+        static constexpr uint64_t CAPACITY = 2048; // Power of two
+
+        alignas(64) std::atomic<uint64_t> head{0}; // Next slot to write
+        uint64_t cachedTail = 0;                   // Producer's last view of tail
+        std::atomic<uint64_t> dropped{0};
+        alignas(64) std::atomic<uint64_t> tail{0}; // Next slot to read
+        std::atomic<bool> retired{false};          // Owner thread has exited
+        uint32_t thread = 0;
+        std::array<Event, CAPACITY> events;
+    };
+
+    struct Logger {
+        std::mutex mutex; // Guards rings, the sink and the drain thread's lifecycle
+        std::vector<std::unique_ptr<Ring>> rings;
+        uint32_t nextThread = 0;
+        uint64_t retiredDrops = 0;
+        std::FILE* out = nullptr;
+        EventLog::Format format = EventLog::Format::JSON_LINES;
+        std::chrono::milliseconds interval{10};
+        std::thread drainer;
+        std::condition_variable wake;
+        bool stopping = false;
+    };
+
+    // Never destroyed: threads may still hold rings while static destructors run
+    Logger& logger() {
+        static Logger* instance = new Logger();
+        return *instance;
+    }
+
+    // Marks the ring retired when its thread exits; the drainer frees it once empty
+    struct RingHandle {
+        Ring* ring = nullptr;
+        ~RingHandle() {
+            if (ring) ring->retired.store(true, std::memory_order_release);
+        }
+    };
+
+    thread_local RingHandle threadRing;
+
+    Ring* registerRing() {
+        Logger& log = logger();
+        std::lock_guard<std::mutex> lock(log.mutex);
+        auto ring = std::make_unique<Ring>();
+        ring->thread = log.nextThread++;
+        threadRing.ring = ring.get();
+        log.rings.push_back(std::move(ring));
+        return threadRing.ring;
+    }
+
+    const char* typeName(EventType type) {
+        switch (type) {
+            case EventType::CAPTURE: return "capture";
+            case EventType::SPAWN: return "spawn";
+            case EventType::FINISH: return "finish";
+            case EventType::WIN: return "win";
+        }
+        return "unknown";
+    }
+
+    const char* levelName(LogLevel level) {
+        static const char* const NAMES[] = {"trace", "debug", "info", "warn", "error"};
+        return NAMES[static_cast<int>(level)];
+    }
+
+    void write(std::FILE* out, EventLog::Format format, const Event& e) {
+        if (format == EventLog::Format::BINARY) {
+            std::fwrite(&e, sizeof(e), 1, out);
+            return;
+        }
+        std::fprintf(out,
+                     "{\"t\":%llu,\"event\":\"%s\",\"level\":\"%s\",\"game\":%llu,\"thread\":%u,"
+                     "\"player\":%d,\"piece\":%d,\"from\":%d,\"to\":%d,\"square\":%d",
+                     static_cast<unsigned long long>(e.timeNs), typeName(e.type), levelName(e.level),
+                     static_cast<unsigned long long>(e.game), e.thread, e.player, e.piece, e.from, e.to, e.square);
+        if (e.type == EventType::CAPTURE) {
+            std::fputs(",\"captured\":[", out);
+            bool first = true;
+            for (int bit = 0; bit < 16; bit++) {
+                if (!(e.captured >> bit & 1)) continue;
+                std::fprintf(out, "%s{\"player\":%d,\"piece\":%d}", first ? "" : ",", bit / 4, bit % 4);
+                first = false;
+            }
+            std::fputc(']', out);
+        }
+        std::fputs("}\n", out);
+    }
+
+    // Copy out everything published so far; caller holds the logger mutex
+    void drainOnce(Logger& log) {
+        for (size_t i = 0; i < log.rings.size();) {
+            Ring& ring = *log.rings[i];
+            const bool retired = ring.retired.load(std::memory_order_acquire);
+            uint64_t tail = ring.tail.load(std::memory_order_relaxed);
+            const uint64_t head = ring.head.load(std::memory_order_acquire);
+            for (; tail != head; tail++) write(log.out, log.format, ring.events[tail & (Ring::CAPACITY - 1)]);
+            ring.tail.store(tail, std::memory_order_release);
+            if (retired) {
+                log.retiredDrops += ring.dropped.load(std::memory_order_relaxed);
+                log.rings.erase(log.rings.begin() + static_cast<std::ptrdiff_t>(i));
+            } else {
+                i++;
+            }
+        }
+        std::fflush(log.out);
+    }
+
+    void drainLoop() {
+        Logger& log = logger();
+        std::unique_lock<std::mutex> lock(log.mutex);
+        while (!log.stopping) {
+            log.wake.wait_for(lock, log.interval, [&] { return log.stopping; });
+            drainOnce(log);
+        }
+    }
+}
+
+void EventLog::start(std::FILE* out, Format format, std::chrono::milliseconds interval) {
+    Logger& log = logger();
+    {
+        std::lock_guard<std::mutex> lock(log.mutex);
+        if (log.drainer.joinable()) return; // Already running
+        log.out = out;
+        log.format = format;
+        log.interval = interval;
+        log.stopping = false;
+        if (format == Format::BINARY) std::fwrite("LUDOEVT1", 1, 8, out);
+        log.drainer = std::thread(drainLoop);
+    }
+    active.store(true, std::memory_order_release);
+    static std::once_flag registered;
+    std::call_once(registered, [] { std::atexit(stop); });
+}
+
+void EventLog::stop() {
+    Logger& log = logger();
+    active.store(false, std::memory_order_release);
+    {
+        std::lock_guard<std::mutex> lock(log.mutex);
+        if (!log.drainer.joinable()) return;
+        log.stopping = true;
+    }
+    log.wake.notify_all();
+    log.drainer.join();
+}
+
+uint64_t EventLog::dropped() {
+    Logger& log = logger();
+    std::lock_guard<std::mutex> lock(log.mutex);
+    uint64_t total = log.retiredDrops;
+    for (const auto& ring : log.rings) total += ring->dropped.load(std::memory_order_relaxed);
+    return total;
+}
+
+void EventLog::push(Event& event) {
+    Ring* ring = threadRing.ring ? threadRing.ring : registerRing();
+    const uint64_t head = ring->head.load(std::memory_order_relaxed);
+    if (head - ring->cachedTail == Ring::CAPACITY) {
+        ring->cachedTail = ring->tail.load(std::memory_order_acquire);
+        if (head - ring->cachedTail == Ring::CAPACITY) {
+            ring->dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+    }
+    event.timeNs = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count());
+    event.thread = ring->thread;
+    ring->events[head & (Ring::CAPACITY - 1)] = event;
+    ring->head.store(head + 1, std::memory_order_release);
+}
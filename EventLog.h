@@ -0,0 +1,70 @@
+#ifndef LUDO_GAME_EVENTLOG_H
+#define LUDO_GAME_EVENTLOG_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+
+// Levels below LUDO_LOG_LEVEL are compiled out entirely (cmake -DLUDO_LOG_LEVEL=N)
+enum class LogLevel : uint8_t { TRACE, DEBUG, INFO, WARN, ERR };
+
+#ifndef LUDO_LOG_LEVEL
+#define LUDO_LOG_LEVEL 2 // INFO
+#endif
+
+enum class EventType : uint8_t { CAPTURE, SPAWN, FINISH, WIN };
+
+// One structured record, written as-is in binary mode. Fixed size and trivially
+// copyable, so emitting one is a handful of stores into the calling thread's ring.
+struct Event {
+    uint64_t timeNs = 0;   // Wall clock, ns since the Unix epoch; stamped by emit()
+    uint64_t game = 0;     // GameManager ID, the number behind the API's base36 ID; 0 if unmanaged
+    uint16_t captured = 0; // CAPTURE: bit = seat * MAX_PIECES + piece sent back to base
+    EventType type = EventType::CAPTURE;
+    LogLevel level = LogLevel::INFO;
+    int8_t player = -1;    // Mover (WIN: the winner)
+    int8_t piece = -1;
+    int8_t from = -1;      // Progress before and after the move
+    int8_t to = -1;
+    int8_t square = -1;    // Global track square landed on, -1 off the shared track
+    uint8_t reserved[3] = {};
+    uint32_t thread = 0;   // Small per-thread index; stamped by emit()
+};
+
+static_assert(sizeof(Event) == 32, "Event records are 32 bytes on disk");
+
+// Asynchronous event log. Each thread writes into its own lock-free single-producer ring;
+// a background thread drains every ring to the sink as JSON lines or raw Event records.
+// After a thread's first event (which registers its ring) emitting never formats,
+// allocates, locks or blocks: when a ring is full the event is dropped and counted.
+// Until start() is called emit() is a single relaxed load.
+class EventLog {
+public:
+    enum class Format { JSON_LINES, BINARY }; // Binary: "LUDOEVT1" then Event records
+
+    // Begin draining to `out` (not closed by the log) every `interval`. Flushed at exit.
+    static void start(std::FILE* out, Format format,
+                      std::chrono::milliseconds interval = std::chrono::milliseconds(10));
+    // Drain what is left, write it out and stop the background thread
+    static void stop();
+
+    static bool running() { return active.load(std::memory_order_relaxed); }
+    static uint64_t dropped();
+
+    template <LogLevel Level>
+    static void emit(Event event) {
+        if constexpr (static_cast<int>(Level) >= LUDO_LOG_LEVEL) {
+            if (!running()) return;
+            event.level = Level;
+            push(event);
+        }
+    }
+
+private:
+    static inline std::atomic<bool> active{false};
+
+    static void push(Event& event);
+};
+
+#endif //LUDO_GAME_EVENTLOG_H
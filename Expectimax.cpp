@@ -0,0 +1,271 @@
+#include "Expectimax.h"
+#include <algorithm>
+#include <cmath>
+
+using namespace Ludo;
+
+namespace {
+    constexpr uint64_t TIME_CHECK_INTERVAL = 1024; // Nodes between clock reads
+
+    // Rough worth of a single piece: advancing matters, safety matters more near home
+    float pieceValue(int8_t playerIdx, int8_t progress) {
+        if (progress < 0) return 0.0f;
+        if (progress == HOME_PROGRESS) return 90.0f;
+        if (progress >= TRACK_SIZE) return 70.0f + 2.0f * (progress - TRACK_SIZE); // Home stretch: uncapturable
+        float value = 10.0f + progress;
+        if (isSafeTrackIndex(globalSquare(playerIdx, progress))) value += 3.0f;
+        return value;
+    }
+
+    float terminalValue(const GameState& state, int8_t player) {
+        return state.winner == player ? Expectimax::WIN : Expectimax::LOSS;
+    }
+
+    TranspositionTable::Bound boundFor(float value, float alpha, float beta) {
+        if (value <= alpha) return TranspositionTable::Bound::UPPER;
+        if (value >= beta) return TranspositionTable::Bound::LOWER;
+        return TranspositionTable::Bound::EXACT;
+    }
+
+    // Can the stored entry answer a query for this depth and window on its own?
+    bool ttCutoff(const TranspositionTable::Entry& e, int depth, float alpha, float beta) {
+        if (e.depth < depth) return false;
+        switch (e.bound) {
+            case TranspositionTable::Bound::EXACT: return true;
+            case TranspositionTable::Bound::LOWER: return e.value >= beta;
+            case TranspositionTable::Bound::UPPER: return e.value <= alpha;
+            default: return false;
+        }
+    }
+}
+
+float Expectimax::evaluate(const GameState& state, int8_t player) {
+    if (isTerminal(state)) return terminalValue(state, player);
+
+    float mine = 0.0f;
+    float strongestOpponent = 0.0f;
+    for (int8_t p = 0; p < state.numPlayers; p++) {
+        float score = 0.0f;
+        for (int8_t prog : state.progress[p]) score += pieceValue(p, prog);
+        if (p == player) mine = score;
+        else strongestOpponent = std::max(strongestOpponent, score);
+    }
+    // Squash into (LOSS, WIN) so heuristic values never tie with a decided game
+    float diff = mine - strongestOpponent;
+    return 0.99f * diff / (std::abs(diff) + 100.0f);
+}
+
+bool Expectimax::timeUp() {
+    if (!aborted && nodes >= nextTimeCheck) {
+        nextTimeCheck = nodes + TIME_CHECK_INTERVAL;
+        aborted = std::chrono::steady_clock::now() >= deadline;
+    }
+    return aborted;
+}
+
+void Expectimax::orderMoves(MoveList& moves, int8_t ttMove) const {
+    auto score = [ttMove](const Move& m) {
+        int s = 0;
+        if (m.piece == ttMove) s += 16;
+        if (m.flags & MOVE_CAPTURE) s += 8;
+        if (m.flags & MOVE_FINISH) s += 4;
+        if (m.flags & MOVE_SPAWN) s += 2;
+        if (m.flags & MOVE_SAFE) s += 1;
+        return s;
+    };
+    // At most four moves: insertion sort, stable so equal scores keep piece order
+    for (int i = 1; i < moves.count; i++) {
+        Move m = moves.moves[i];
+        int j = i;
+        while (j > 0 && score(moves.moves[j - 1]) < score(m)) {
+            moves.moves[j] = moves.moves[j - 1];
+            j--;
+        }
+        moves.moves[j] = m;
+    }
+}
+
+float Expectimax::afterMove(GameState& state, const Move& move, int depth, float alpha, float beta) {
+    const UndoRecord undo = applyMove(state, move.piece);
+    float value = isTerminal(state) ? terminalValue(state, rootPlayer)
+                                    : chance(state, depth - 1, alpha, beta);
+    undoMove(state, undo);
+    return value;
+}
+
+float Expectimax::decision(GameState& state, int depth, float alpha, float beta) {
+    nodes++;
+    if (timeUp()) return 0.0f;
+
+    const uint64_t key = state.hash ^ perspective;
+    int8_t ttMove = -1;
+    TranspositionTable::Entry entry;
+    if (tt.probe(key, entry)) {
+        if (ttCutoff(entry, depth, alpha, beta)) return entry.value;
+        ttMove = entry.move;
+    }
+
+    MoveList moves;
+    generateMoves(state, state.roll, moves);
+    orderMoves(moves, ttMove);
+
+    // Paranoid: the root player maximises, everyone else minimises
+    const bool maximizing = state.currentPlayer == rootPlayer;
+    float best = maximizing ? LOSS : WIN;
+    int8_t bestMove = moves[0].piece;
+    float a = alpha, b = beta;
+    for (const Move& m : moves) {
+        float v = afterMove(state, m, depth, a, b);
+        if (aborted) return 0.0f;
+        if (maximizing ? v > best : v < best) {
+            best = v;
+            bestMove = m.piece;
+        }
+        if (maximizing) a = std::max(a, best);
+        else b = std::min(b, best);
+        if (a >= b) break;
+    }
+
+    tt.store(key, best, static_cast<int8_t>(depth), boundFor(best, alpha, beta), bestMove);
+    return best;
+}
+
+float Expectimax::chance(const GameState& state, int depth, float alpha, float beta) {
+    nodes++;
+    if (depth <= 0) return evaluate(state, rootPlayer);
+    if (timeUp()) return 0.0f;
+
+    const uint64_t key = state.hash ^ perspective;
+    TranspositionTable::Entry entry;
+    if (tt.probe(key, entry) && ttCutoff(entry, depth, alpha, beta)) return entry.value;
+
+    // Every outcome has probability 1/6, so bounds are tracked on the sum of child values
+    const float sumAlpha = DIE_FACES * alpha;
+    const float sumBeta = DIE_FACES * beta;
+
+    std::array<GameState, DIE_FACES> children;
+    std::array<float, DIE_FACES> lo, hi;
+    for (int i = 0; i < DIE_FACES; i++) {
+        children[i] = state;
+        applyRoll(children[i], static_cast<int8_t>(i + 1));
+        lo[i] = LOSS;
+        hi[i] = WIN;
+    }
+
+    auto finish = [&](float sum, float a, float b) {
+        float value = sum / DIE_FACES;
+        tt.store(key, value, static_cast<int8_t>(depth), boundFor(sum, a, b), -1);
+        return value;
+    };
+
+    // Star2 probing: searching only the first ordered move of each decision child gives a
+    // lower bound for a maximising child and an upper bound for a minimising one.
+    // If the bounds alone already decide the node, the full search is skipped.
+    float sumLo = DIE_FACES * LOSS, sumHi = DIE_FACES * WIN;
+    for (int i = 0; i < DIE_FACES; i++) {
+        GameState& child = children[i];
+        if (child.phase != Phase::WAITING_FOR_MOVE) continue;
+
+        int8_t ttMove = -1;
+        if (tt.probe(child.hash ^ perspective, entry)) ttMove = entry.move;
+        MoveList moves;
+        generateMoves(child, child.roll, moves);
+        orderMoves(moves, ttMove);
+
+        if (child.currentPlayer == rootPlayer) {
+            float b = std::min(sumBeta - (sumLo - lo[i]), WIN);
+            float w = afterMove(child, moves[0], depth, LOSS, b);
+            if (aborted) return 0.0f;
+            sumLo += w - lo[i];
+            lo[i] = w;
+            if (sumLo >= sumBeta) return finish(sumLo, sumAlpha, sumBeta);
+        } else {
+            float a = std::max(sumAlpha - (sumHi - hi[i]), LOSS);
+            float w = afterMove(child, moves[0], depth, a, WIN);
+            if (aborted) return 0.0f;
+            sumHi += w - hi[i];
+            hi[i] = w;
+            if (sumHi <= sumAlpha) return finish(sumHi, sumAlpha, sumBeta);
+        }
+    }
+
+    // Star1 search: each child gets the window that could still move the sum across alpha or beta
+    float sumKnown = 0.0f;
+    float restLo = sumLo, restHi = sumHi;
+    for (int i = 0; i < DIE_FACES; i++) {
+        restLo -= lo[i];
+        restHi -= hi[i];
+        const float childAlpha = sumAlpha - sumKnown - restHi;
+        const float childBeta = sumBeta - sumKnown - restLo;
+        const float a = std::max(childAlpha, lo[i]);
+        const float b = std::min(childBeta, hi[i]);
+
+        float v;
+        if (a >= b) {
+            v = lo[i] >= childBeta ? lo[i] : hi[i]; // Already decided by the probe bounds
+        } else if (children[i].phase == Phase::WAITING_FOR_MOVE) {
+            v = decision(children[i], depth, a, b);
+        } else {
+            // Nothing could move: the turn passed. Counts as a ply so all-pass cycles terminate.
+            v = chance(children[i], depth - 1, a, b);
+        }
+        if (aborted) return 0.0f;
+
+        if (v <= childAlpha) return finish(sumKnown + v + restHi, sumAlpha, sumBeta);
+        if (v >= childBeta) return finish(sumKnown + v + restLo, sumAlpha, sumBeta);
+        sumKnown += v;
+    }
+    return finish(sumKnown, sumAlpha, sumBeta);
+}
+
+Expectimax::Result Expectimax::search(const GameState& root, std::chrono::nanoseconds budget, int maxDepth) {
+    const auto start = std::chrono::steady_clock::now();
+    rootPlayer = root.currentPlayer;
+    perspective = 0x9E3779B97F4A7C15ull * static_cast<uint64_t>(rootPlayer + 1); // Values depend on who is asking
+    nodes = 0;
+    nextTimeCheck = TIME_CHECK_INTERVAL;
+    aborted = false;
+    tt.newSearch();
+
+    Result result{{-1, -1, -1, 0}, 0.0f, 0, 0};
+    if (root.phase != Phase::WAITING_FOR_MOVE) return result;
+
+    GameState state = root;
+    MoveList moves;
+    generateMoves(state, state.roll, moves);
+    orderMoves(moves, -1);
+    result.move = moves[0];
+    result.value = evaluate(state, rootPlayer);
+    if (moves.size() == 1) return result; // Forced
+
+    for (int depth = 1; depth <= maxDepth; depth++) {
+        // Depth 1 runs without a deadline so there is always a searched move to return
+        deadline = depth == 1 ? std::chrono::steady_clock::time_point::max() : start + budget;
+        float best = LOSS;
+        Move bestMove = moves[0];
+        float alpha = LOSS;
+        for (const Move& m : moves) {
+            float v = afterMove(state, m, depth, alpha, WIN);
+            if (aborted) break;
+            if (v > best || &m == moves.begin()) {
+                best = v;
+                bestMove = m;
+            }
+            alpha = std::max(alpha, best);
+        }
+        if (aborted) break; // A partial iteration is discarded
+
+        result.move = bestMove;
+        result.value = best;
+        result.depth = depth;
+
+        // Search the previous best first next time
+        orderMoves(moves, bestMove.piece);
+
+        // The next iteration costs several times this one; do not start what cannot finish
+        auto elapsed = std::chrono::steady_clock::now() - start;
+        if (elapsed * 2 >= budget) break;
+    }
+    result.nodes = nodes;
+    return result;
+}
@@ -0,0 +1,52 @@
+#ifndef LUDO_GAME_EXPECTIMAX_H
+#define LUDO_GAME_EXPECTIMAX_H
+
+#include <chrono>
+#include <cstdint>
+#include "GameState.h"
+#include "MoveGen.h"
+#include "TranspositionTable.h"
+
+// Expectimax over dice outcomes with Star1/Star2 chance-node pruning.
+// Multi-player positions are searched paranoid-style: the root player maximises and every
+// opponent minimises the root player's value, which keeps the tree zero-sum so the
+// alpha-beta style bounds of Star1/Star2 stay valid.
+class Expectimax {
+public:
+    // Every value lies in [LOSS, WIN]; Star1/Star2 need these hard bounds
+    static constexpr float LOSS = -1.0f;
+    static constexpr float WIN = 1.0f;
+
+    struct Result {
+        Ludo::Move move;   // piece == -1 if nothing can move
+        float value;       // From the mover's point of view
+        int depth;         // Deepest completed iteration
+        uint64_t nodes;
+    };
+
+    explicit Expectimax(TranspositionTable& table) : tt(table) {}
+
+    // Iterative deepening from a position waiting for a move, until `budget` runs out
+    // or `maxDepth` plies are complete. Depth 1 always completes.
+    Result search(const Ludo::GameState& state, std::chrono::nanoseconds budget, int maxDepth = 32);
+
+    // Static evaluation from `player`'s point of view, strictly inside (LOSS, WIN)
+    static float evaluate(const Ludo::GameState& state, int8_t player);
+
+private:
+    TranspositionTable& tt;
+    int8_t rootPlayer = 0;
+    uint64_t perspective = 0;
+    uint64_t nodes = 0;
+    uint64_t nextTimeCheck = 0;
+    std::chrono::steady_clock::time_point deadline;
+    bool aborted = false;
+
+    float decision(Ludo::GameState& state, int depth, float alpha, float beta);
+    float chance(const Ludo::GameState& state, int depth, float alpha, float beta);
+    float afterMove(Ludo::GameState& state, const Ludo::Move& move, int depth, float alpha, float beta);
+    void orderMoves(Ludo::MoveList& moves, int8_t ttMove) const;
+    bool timeUp();
+};
+
+#endif //LUDO_GAME_EXPECTIMAX_H
@@ -0,0 +1,109 @@
+#ifndef LUDO_GAME_FLATMAP_H
+#define LUDO_GAME_FLATMAP_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <utility>
+#include <vector>
+
+// Open-addressing hash map with linear probing over one contiguous slot array. Lookups touch
+// a run of adjacent slots instead of chasing tree or bucket nodes. Erase shifts the following
+// run back, so there are no tombstones and probe runs never degrade. Not thread-safe.
+// Hash values are spread with a Fibonacci multiply, so identity hashes of integers are fine.
+template <class Key, class Value, class Hash = std::hash<Key>>
+class FlatMap {
+public:
+    explicit FlatMap(size_t initialCapacity = 16) {
+        size_t capacity = 16;
+        while (capacity < initialCapacity) capacity *= 2;
+        rehash(capacity);
+    }
+
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+
+    Value* find(const Key& key) {
+        for (size_t i = home(key);; i = next(i)) {
+            Slot& slot = slots[i];
+            if (!slot.used) return nullptr;
+            if (slot.key == key) return &slot.value;
+        }
+    }
+
+    const Value* find(const Key& key) const { return const_cast<FlatMap*>(this)->find(key); }
+
+    // False (and no change) when the key is already present
+    bool insert(const Key& key, Value value) {
+        if ((count + 1) * 2 > slots.size()) rehash(slots.size() * 2); // Keep load at or below 1/2
+        size_t i = home(key);
+        for (; slots[i].used; i = next(i)) {
+            if (slots[i].key == key) return false;
+        }
+        slots[i].key = key;
+        slots[i].value = std::move(value);
+        slots[i].used = true;
+        count++;
+        return true;
+    }
+
+    bool erase(const Key& key) {
+        size_t i = home(key);
+        for (; slots[i].used; i = next(i)) {
+            if (slots[i].key == key) break;
+        }
+        if (!slots[i].used) return false;
+
+        // Backward-shift: pull later entries of the run into the hole if that keeps them
+        // at or after their home slot
+        for (size_t j = next(i);; j = next(j)) {
+            if (!slots[j].used) break;
+            const size_t h = home(slots[j].key);
+            const bool movable = i <= j ? (h <= i || h > j) : (h <= i && h > j);
+            if (movable) {
+                slots[i] = std::move(slots[j]);
+                i = j;
+            }
+        }
+        slots[i] = Slot();
+        count--;
+        return true;
+    }
+
+    template <class F>
+    void forEach(F&& f) {
+        for (Slot& slot : slots) {
+            if (slot.used) f(slot.key, slot.value);
+        }
+    }
+
+private:
+    struct Slot {
+        Key key{};
+        Value value{};
+        bool used = false;
+    };
+
+    std::vector<Slot> slots;
+    size_t count = 0;
+    int shift = 64;
+    Hash hasher;
+
+    size_t home(const Key& key) const {
+        return static_cast<size_t>((uint64_t(hasher(key)) * 0x9E3779B97F4A7C15ull) >> shift);
+    }
+
+    size_t next(size_t i) const { return (i + 1) & (slots.size() - 1); }
+
+    void rehash(size_t capacity) {
+        std::vector<Slot> old = std::exchange(slots, std::vector<Slot>(capacity));
+        shift = 64;
+        for (size_t c = capacity; c > 1; c /= 2) shift--;
+        count = 0;
+        for (Slot& slot : old) {
+            if (slot.used) insert(slot.key, std::move(slot.value));
+        }
+    }
+};
+
+#endif //LUDO_GAME_FLATMAP_H
@@ -1,191 +1,216 @@
 #include "Game.h"
 #include <algorithm>
-#include <iostream>
+#include <bit>
+#include "EventLog.h"
+#include "Metrics.h"
+
+namespace {
+    // Every gameMutex acquisition, with its wait recorded for /metrics
+    std::unique_lock<std::recursive_mutex> lockGame(std::recursive_mutex& mutex) {
+        return Metrics::lockTimed<std::unique_lock<std::recursive_mutex>>(mutex, Metrics::engine().gameLockWait);
+    }
+
+    // Structured events for a move just applied; nothing is built unless a log is running
+    template <class S>
+    void logMove(const S& position, uint64_t gameId, const Ludo::UndoRecord& undo) {
+        if (!EventLog::running()) return;
+        Event event;
+        event.game = gameId;
+        event.player = undo.player;
+        event.piece = undo.piece;
+        event.from = undo.from;
+        event.to = position.progress[undo.player][undo.piece];
+        event.square = static_cast<int8_t>(Ludo::globalSquare(undo.player, event.to));
+
+        if (undo.from < 0) {
+            event.type = EventType::SPAWN;
+            EventLog::emit<LogLevel::DEBUG>(event);
+        }
+        if (undo.captured) {
+            event.type = EventType::CAPTURE;
+            event.captured = undo.captured;
+            EventLog::emit<LogLevel::INFO>(event);
+            event.captured = 0;
+        }
+        if (event.to == Ludo::HOME_PROGRESS) {
+            event.type = EventType::FINISH;
+            EventLog::emit<LogLevel::INFO>(event);
+        }
+        if (position.phase == Ludo::Phase::GAME_OVER && undo.phase != Ludo::Phase::GAME_OVER) {
+            event.type = EventType::WIN;
+            event.player = position.winner;
+            EventLog::emit<LogLevel::INFO>(event);
+        }
+    }
+}
+
+template <int Players, class Rng>
+BasicGame<Players, Rng>::BasicGame()
+    : BasicGame(uint64_t(std::random_device{}()) << 32 | std::random_device{}()) {}
 
-Game::Game() : state(State::WAITING_FOR_PLAYERS) {
-    std::random_device rd;
-    rng.seed(rd());
-    trackOccupancy.fill({-1, 0});
+template <int Players, class Rng>
+BasicGame<Players, Rng>::BasicGame(uint64_t seed)
+    : position(Ludo::makeFixedGameState<Players>()), seed(seed), rng(seed) {
+    position.phase = State::WAITING_FOR_PLAYERS;
 }
 
-bool Game::addPlayer(const Player &player) {
-    std::lock_guard<std::recursive_mutex> lock(gameMutex);
-    if (players.size() >= Ludo::MAX_PLAYERS) return false;
+template <int Players, class Rng>
+bool BasicGame<Players, Rng>::addPlayer(const Player &player) {
+    auto lock = lockGame(gameMutex);
+    if (players.size() >= Players) return false;
     players.push_back(player);
-    if (players.size() >= 2) state = State::WAITING_FOR_ROLL;
+    if (players.size() == Players) position.phase = State::WAITING_FOR_ROLL;
+    changed();
     return true;
 }
 
-int8_t Game::generateRandomNumber() {
-    std::uniform_int_distribution<> distrib(1, 6);
-    return static_cast<int8_t>(distrib(rng));
+template <int Players, class Rng>
+int8_t BasicGame<Players, Rng>::generateRandomNumber() {
+    return Ludo::rollDie(rng);
 }
 
-void Game::nextTurn() {
-    currentPlayerIndex = (currentPlayerIndex + 1) % players.size();
-    state = State::WAITING_FOR_ROLL;
+// Locked like every other accessor: the reaper and request threads read these while
+// other requests move pieces
+template <int Players, class Rng>
+int8_t BasicGame<Players, Rng>::getCurrentPlayer() const {
+    auto lock = lockGame(gameMutex);
+    return position.currentPlayer;
 }
 
-void Game::handleCapture(int8_t playerIdx, int8_t progress) {
-    if (progress < 0 || progress >= Ludo::TRACK_SIZE) return;
-
-    // Convert local progress to global track index
-    int globalIdx = (progress + (playerIdx * 13)) % Ludo::TRACK_SIZE;
-    
-    // Safety check: is it a safe spot?
-    Ludo::Coord coord = Board::getCoord(playerIdx, progress);
-    if (Board::isSafeSpot(coord.r, coord.c)) return;
-
-    auto& occupant = trackOccupancy[globalIdx];
-    if (occupant.playerIdx != -1 && occupant.playerIdx != playerIdx) {
-        // Capture!
-        std::cout << "HFT capture at track " << globalIdx << " by P" << (int)playerIdx << std::endl;
-        
-        // Reset all pieces of the other player on this square
-        for (int i = 0; i < Ludo::MAX_PIECES; i++) {
-            int otherProgress = players[occupant.playerIdx].pieceProgress[i];
-            if (otherProgress >= 0 && otherProgress < Ludo::TRACK_SIZE) {
-                int otherGlobal = (otherProgress + (occupant.playerIdx * 13)) % Ludo::TRACK_SIZE;
-                if (otherGlobal == globalIdx) {
-                    players[occupant.playerIdx].resetPiece(i);
-                }
-            }
-        }
-        occupant.playerIdx = playerIdx;
-        occupant.piecesCount = 1; // The capturing piece
-    }
+template <int Players, class Rng>
+Game::State BasicGame<Players, Rng>::getGameStateEnum() const {
+    auto lock = lockGame(gameMutex);
+    return position.phase;
 }
 
-bool Game::hasPossibleMoves(int8_t pIdx, int8_t roll) const {
-    const auto& p = players[pIdx];
-    for (int i = 0; i < Ludo::MAX_PIECES; i++) {
-        if (p.pieceProgress[i] == -1) {
-            if (roll == 6) return true;
-        } else if (!p.isAtHome[i]) {
-            if (p.pieceProgress[i] + roll < Ludo::TOTAL_PROGRESS_STEPS) return true;
-        }
-    }
-    return false;
+template <int Players, class Rng>
+Ludo::GameState BasicGame<Players, Rng>::snapshot() const {
+    auto lock = lockGame(gameMutex);
+    return Ludo::toGameState(position);
 }
 
-int8_t Game::rollDiceForPlayer(int8_t pIdx) {
-    std::lock_guard<std::recursive_mutex> lock(gameMutex);
-    if (state != State::WAITING_FOR_ROLL || pIdx != currentPlayerIndex) return -1;
-
-    currentRoll = generateRandomNumber();
-    if (hasPossibleMoves(pIdx, currentRoll)) {
-        state = State::WAITING_FOR_MOVE;
-    } else {
-        // Skip turn
-        nextTurn();
+template <int Players, class Rng>
+Ludo::MoveList BasicGame<Players, Rng>::getLegalMoves() const {
+    auto lock = lockGame(gameMutex);
+    Ludo::MoveList moves;
+    if (position.phase == State::WAITING_FOR_MOVE) {
+        Ludo::generateMoves(position, position.roll, moves);
     }
-    return currentRoll;
+    return moves;
 }
 
-bool Game::makeMoveForPlayer(int8_t pIdx, int8_t pieceIdx) {
-    std::lock_guard<std::recursive_mutex> lock(gameMutex);
-    if (state != State::WAITING_FOR_MOVE || pIdx != currentPlayerIndex) return false;
-    if (pieceIdx < 0 || pieceIdx >= Ludo::MAX_PIECES) return false;
-
-    Player& p = players[pIdx];
-    int8_t currentProg = p.pieceProgress[pieceIdx];
-
-    // Case 1: Spawn
-    if (currentProg == -1) {
-        if (currentRoll != 6) return false;
-        p.pieceProgress[pieceIdx] = 0;
-    } 
-    // Case 2: Move
-    else if (!p.isAtHome[pieceIdx]) {
-        int8_t nextProg = currentProg + currentRoll;
-        if (nextProg >= Ludo::TOTAL_PROGRESS_STEPS) return false;
-        
-        // Remove from old global occupancy if on track
-        if (currentProg < Ludo::TRACK_SIZE) {
-            int oldGlobal = (currentProg + (pIdx * 13)) % Ludo::TRACK_SIZE;
-            if (--trackOccupancy[oldGlobal].piecesCount <= 0) {
-                trackOccupancy[oldGlobal].playerIdx = -1;
-            }
-        }
+template <int Players, class Rng>
+int8_t BasicGame<Players, Rng>::rollDiceForPlayer(int8_t pIdx) {
+    auto lock = lockGame(gameMutex);
+    if (position.phase != State::WAITING_FOR_ROLL || pIdx != position.currentPlayer) return -1;
 
-        p.pieceProgress[pieceIdx] = nextProg;
-        if (nextProg == Ludo::TOTAL_PROGRESS_STEPS - 1) {
-            p.isAtHome[pieceIdx] = true;
-        }
-
-        // Handle collision/capture if on track
-        if (nextProg < Ludo::TRACK_SIZE) {
-            handleCapture(pIdx, nextProg);
-            int newGlobal = (nextProg + (pIdx * 13)) % Ludo::TRACK_SIZE;
-            trackOccupancy[newGlobal].playerIdx = pIdx;
-            trackOccupancy[newGlobal].piecesCount++;
-        }
-    } else {
-        return false; // Already home
-    }
+    int8_t roll = generateRandomNumber();
+    Ludo::applyRoll(position, roll); // Skips the turn if nothing can move
+    canUndo = false;
+    changed();
+    return roll;
+}
 
-    checkWinCondition();
-    if (state != State::GAME_OVER) {
-        if (currentRoll == 6) {
-            state = State::WAITING_FOR_ROLL; // Same player rolls again
-        } else {
-            nextTurn();
-        }
-    }
+template <int Players, class Rng>
+bool BasicGame<Players, Rng>::makeMoveForPlayer(int8_t pIdx, int8_t pieceIdx) {
+    auto lock = lockGame(gameMutex);
+    if (pIdx != position.currentPlayer || !Ludo::isLegalMove(position, pieceIdx)) return false;
+
+    const Ludo::UndoRecord undo = Ludo::applyMove(position, pieceIdx);
+    lastMove = undo;
+    canUndo = true;
+    Metrics::engine().moves.add();
+    if (undo.captured) Metrics::engine().captures.add(std::popcount(undo.captured));
+    logMove(position, gameId, undo);
+    changed();
     return true;
 }
 
-void Game::checkWinCondition() {
-    for (const auto& p : players) {
-        bool allHome = true;
-        for (bool home : p.isAtHome) {
-            if (!home) { allHome = false; break; }
-        }
-        if (allHome) {
-            winnerId = p.getId();
-            state = State::GAME_OVER;
-            return;
-        }
-    }
+template <int Players, class Rng>
+int8_t BasicGame<Players, Rng>::undoLastMove(int8_t pIdx) {
+    auto lock = lockGame(gameMutex);
+    if (!canUndo) return -2;
+    if (lastMove.player != pIdx) return -1;
+
+    // Restores the mover, the pending roll and any captured pieces
+    Ludo::undoMove(position, lastMove);
+    canUndo = false;
+    changed();
+    return lastMove.piece;
 }
 
-json Game::getGameState() const {
-    std::lock_guard<std::recursive_mutex> lock(gameMutex);
+template <int Players, class Rng>
+json BasicGame<Players, Rng>::getGameState() const {
+    auto lock = lockGame(gameMutex);
     json j;
-    j["current_turn"] = currentPlayerIndex;
-    j["last_roll"] = currentRoll;
-    j["state"] = (int)state;
-    j["winner"] = winnerId;
+    j["current_turn"] = position.currentPlayer;
+    j["last_roll"] = position.roll;
+    j["state"] = (int)position.phase;
+    j["winner"] = position.winner;
     j["players"] = json::array();
     
-    for (const auto& p : players) {
+    for (size_t seat = 0; seat < players.size(); seat++) {
+        const Player& p = players[seat];
         json pj;
         pj["id"] = p.getId();
         pj["name"] = p.getName();
         pj["color"] = p.getColor();
         pj["pieces"] = json::array();
-        for (int i = 0; i < Ludo::MAX_PIECES; i++) {
-            Ludo::Coord c = Board::getCoord(p.getId(), p.pieceProgress[i]);
+        for (int8_t prog : position.progress[seat]) {
+            Ludo::Coord c = Ludo::progressCoord(static_cast<int>(seat), prog);
             pj["pieces"].push_back({
                 {"row", c.r},
                 {"col", c.c},
-                {"progress", p.pieceProgress[i]},
-                {"home", p.isAtHome[i]}
+                {"progress", prog},
+                {"home", prog == Ludo::HOME_PROGRESS}
             });
         }
         j["players"].push_back(pj);
     }
+
+    j["legal_moves"] = json::array();
+    for (const Ludo::Move& m : getLegalMoves()) {
+        j["legal_moves"].push_back({
+            {"piece", m.piece},
+            {"from", m.from},
+            {"to", m.to},
+            {"spawn", (m.flags & Ludo::MOVE_SPAWN) != 0},
+            {"capture", (m.flags & Ludo::MOVE_CAPTURE) != 0},
+            {"safe", (m.flags & Ludo::MOVE_SAFE) != 0},
+            {"finish", (m.flags & Ludo::MOVE_FINISH) != 0}
+        });
+    }
     return j;
 }
 
-void Game::resetGame() {
-    std::lock_guard<std::recursive_mutex> lock(gameMutex);
-    for (auto& p : players) {
-        for (int i = 0; i < Ludo::MAX_PIECES; i++) p.resetPiece(i);
+template <int Players, class Rng>
+void BasicGame<Players, Rng>::resetGame() {
+    auto lock = lockGame(gameMutex);
+    position = Ludo::makeFixedGameState<Players>();
+    if (players.size() < Players) position.phase = State::WAITING_FOR_PLAYERS;
+    canUndo = false;
+    changed();
+}
+
+template <int Players, class Rng>
+void BasicGame<Players, Rng>::reseed(uint64_t newSeed, uint64_t newId) {
+    auto lock = lockGame(gameMutex);
+    seed = newSeed;
+    gameId = newId;
+    rng = Rng(newSeed);
+    resetGame();
+}
+
+template class BasicGame<2>;
+template class BasicGame<3>;
+template class BasicGame<4>;
+template class BasicGame<4, Ludo::Philox4x32>;
+
+std::shared_ptr<Game> Game::create(int numPlayers, uint64_t seed) {
+    switch (numPlayers) {
+        case 2: return std::make_shared<BasicGame<2>>(seed);
+        case 3: return std::make_shared<BasicGame<3>>(seed);
+        case 4: return std::make_shared<BasicGame<4>>(seed);
+        default: return nullptr;
     }
-    trackOccupancy.fill({-1, 0});
-    currentPlayerIndex = 0;
-    currentRoll = 0;
-    winnerId = -1;
-    state = State::WAITING_FOR_ROLL;
 }
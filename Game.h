@@ -3,66 +3,130 @@
 
 #include "Player.h"
 #include "Board.h"
+#include "GameState.h"
+#include "MoveGen.h"
 #include "Constants.h"
+#include "Random.h"
 #include <vector>
 #include <array>
+#include <atomic>
+#include <memory>
 #include <random>
 #include <mutex>
 #include "libs/json.hpp"
 
 using json = nlohmann::json;
 
+// Runtime face of a game. GameManager and the server hold every game through this
+// interface; the rules run in BasicGame<Players>, specialised for the seat count.
 class Game {
 public:
-    enum class State {
-        WAITING_FOR_PLAYERS,
-        WAITING_FOR_ROLL,
-        WAITING_FOR_MOVE,
-        GAME_OVER
-    };
+    using State = Ludo::Phase;
+
+    virtual ~Game() = default;
+
+    // Players: 2-4. Seeded games replay exactly given the same actions.
+    static std::shared_ptr<Game> create(int numPlayers, uint64_t seed);
+
+    // Core Game Actions
+    virtual bool addPlayer(const Player &player) = 0;
+    void startGame();
+    virtual int8_t rollDiceForPlayer(int8_t pIdx) = 0;
+    virtual bool makeMoveForPlayer(int8_t pIdx, int8_t pieceIdx) = 0;
+    // Take back the latest move if `pIdx` made it and nobody has rolled since: a roll
+    // draws from the dice stream, so undoing past one would let a player reroll.
+    // Returns the piece moved back, -1 if another player made that move, -2 if there
+    // is nothing to undo.
+    virtual int8_t undoLastMove(int8_t pIdx) = 0;
+    virtual void resetGame() = 0;
+
+    // Start over as a fresh game with a new seed, keeping the seated players. Lets
+    // GameManager reuse a game object instead of building and seating a new one.
+    // `newId` is the GameManager ID the game is registered under, recorded in its events.
+    virtual void reseed(uint64_t newSeed, uint64_t newId) = 0;
+
+    // API Helpers
+    virtual json getGameState() const = 0;
+    virtual int8_t getCurrentPlayer() const = 0;
+    virtual State getGameStateEnum() const = 0;
+    virtual int8_t getNumPlayers() const = 0;
+    virtual uint64_t getSeed() const = 0;
+
+    // Consistent copy of the position for bots, search and replay
+    virtual Ludo::GameState snapshot() const = 0;
+
+    // Moves available for the pending roll (empty unless waiting for a move)
+    virtual Ludo::MoveList getLegalMoves() const = 0;
+
+    // Last access in GameManager ticks, for idle eviction. Relaxed: an estimate is enough.
+    void touch(int64_t tick) { lastActive.store(tick, std::memory_order_relaxed); }
+    int64_t lastTouched() const { return lastActive.load(std::memory_order_relaxed); }
+
+    // Bumped after every change to the position, never reset (not even by reseed), so
+    // it works as a cache validator without taking the game lock. Read it before the
+    // state it describes: the state is then at least as new as the version.
+    uint64_t version() const { return changes.load(std::memory_order_acquire); }
+
+protected:
+    // Call with the game lock held, after the change
+    void changed() { changes.fetch_add(1, std::memory_order_release); }
+
+private:
+    std::atomic<int64_t> lastActive{0};
+    std::atomic<uint64_t> changes{0};
+};
+
+// Players fixes the seat count at compile time (see FixedGameState).
+// Rng is the dice policy: any 64-bit std::uniform_random_bit_generator from Random.h.
+template <int Players, class Rng = Ludo::Xoshiro256ss>
+class BasicGame final : public Game {
+public:
+    using Random = Rng;
 
 private:
     std::vector<Player> players;
-    int8_t currentPlayerIndex = 0;
-    int8_t currentRoll = 0;
-    int8_t winnerId = -1;
-    State state = State::WAITING_FOR_PLAYERS;
 
-    std::mt19937 rng;
-    mutable std::recursive_mutex gameMutex;
+    // The whole position; Game only adds identities, randomness and locking on top
+    Ludo::FixedGameState<Players> position;
+
+    // The move undoLastMove takes back; cleared by the next roll
+    Ludo::UndoRecord lastMove{};
+    bool canUndo = false;
 
-    // Fast mapping for collision detection: track_index -> list of piece info
-    // However, in Ludo only one piece (or stacked pieces of SAME player) can be on a square.
-    // Except for safe spots.
-    struct SquareInfo {
-        int8_t playerIdx = -1;
-        int8_t piecesCount = 0;
-    };
-    std::array<SquareInfo, Ludo::TRACK_SIZE> trackOccupancy;
+    uint64_t seed;
+    uint64_t gameId = 0; // Set by reseed; 0 for games no GameManager registered
+    Rng rng;
+    mutable std::recursive_mutex gameMutex;
 
     // Helper functions
     int8_t generateRandomNumber();
-    void nextTurn();
-    void handleCapture(int8_t playerIdx, int8_t progress);
-    void checkWinCondition();
 
 public:
-    Game();
-    
+    BasicGame(); // Seeded from std::random_device
+    explicit BasicGame(uint64_t seed); // Same seed and same actions replay the same game
+
     // Core Game Actions
-    bool addPlayer(const Player &player);
-    void startGame();
-    int8_t rollDiceForPlayer(int8_t pIdx);
-    bool makeMoveForPlayer(int8_t pIdx, int8_t pieceIdx);
-    void resetGame();
+    bool addPlayer(const Player &player) override;
+    int8_t rollDiceForPlayer(int8_t pIdx) override;
+    bool makeMoveForPlayer(int8_t pIdx, int8_t pieceIdx) override;
+    int8_t undoLastMove(int8_t pIdx) override;
+    void resetGame() override;
+    void reseed(uint64_t newSeed, uint64_t newId) override;
 
     // API Helpers
-    json getGameState() const;
-    int8_t getCurrentPlayer() const { return currentPlayerIndex; }
-    State getGameStateEnum() const { return state; }
+    json getGameState() const override;
+    int8_t getCurrentPlayer() const override;
+    State getGameStateEnum() const override;
+    int8_t getNumPlayers() const override { return Players; }
+    uint64_t getSeed() const override { return seed; }
 
-    // Optimization: Pre-check if any moves are possible
-    bool hasPossibleMoves(int8_t pIdx, int8_t roll) const;
+    Ludo::GameState snapshot() const override;
+    Ludo::MoveList getLegalMoves() const override;
 };
 
+extern template class BasicGame<2>;
+extern template class BasicGame<3>;
+extern template class BasicGame<4>;
+extern template class BasicGame<4, Ludo::Philox4x32>;
+
 #endif //LUDO_GAME_GAME_H
@@ -0,0 +1,38 @@
+#include "GameFeed.h"
+
+std::shared_ptr<GameFeed::Channel> GameFeed::subscribe(GameId gameId) {
+    std::lock_guard<std::mutex> lock(mutex);
+    std::shared_ptr<Channel>* found = channels.find(gameId);
+    std::shared_ptr<Channel> channel = found ? *found : std::make_shared<Channel>();
+    if (!found) channels.insert(gameId, channel);
+    std::lock_guard<std::mutex> channelLock(channel->mutex);
+    channel->subscribers++;
+    return channel;
+}
+
+void GameFeed::unsubscribe(GameId gameId, const std::shared_ptr<Channel>& channel) {
+    std::lock_guard<std::mutex> lock(mutex);
+    std::lock_guard<std::mutex> channelLock(channel->mutex);
+    // The last subscriber out drops the channel; a new one starts from a fresh channel
+    if (--channel->subscribers == 0) channels.erase(gameId);
+}
+
+void GameFeed::publish(GameId gameId) {
+    std::shared_ptr<Channel> channel;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        std::shared_ptr<Channel>* found = channels.find(gameId);
+        if (!found) return;
+        channel = *found;
+    }
+    {
+        std::lock_guard<std::mutex> lock(channel->mutex);
+        channel->sequence++;
+    }
+    channel->changed.notify_all();
+}
+
+bool GameFeed::wait(Channel& channel, uint64_t seen, std::chrono::milliseconds timeout) {
+    std::unique_lock<std::mutex> lock(channel.mutex);
+    return channel.changed.wait_for(lock, timeout, [&] { return channel.sequence != seen; });
+}
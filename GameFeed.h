@@ -0,0 +1,44 @@
+#ifndef LUDO_GAME_GAMEFEED_H
+#define LUDO_GAME_GAMEFEED_H
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include "FlatMap.h"
+#include "GameManager.h"
+
+// Change notification for server-sent event streams. Each watched game has a channel with
+// a change sequence and its subscribers waiting on it; mutating requests publish() after
+// they succeed, which wakes only that game's subscribers. Games nobody watches cost one
+// map lookup per publish.
+class GameFeed {
+public:
+    struct Channel {
+        std::mutex mutex;
+        std::condition_variable changed;
+        uint64_t sequence = 1; // Bumped by every publish
+        int subscribers = 0;
+
+        // Last serialized state and the sequence it was taken at, shared by every subscriber
+        uint64_t payloadSequence = 0;
+        std::string payload;
+    };
+
+    std::shared_ptr<Channel> subscribe(GameId gameId);
+    void unsubscribe(GameId gameId, const std::shared_ptr<Channel>& channel);
+
+    // The game changed: wake its subscribers, if any
+    void publish(GameId gameId);
+
+    // Block until the channel moves past `seen` or `timeout` passes; true on a change
+    static bool wait(Channel& channel, uint64_t seen, std::chrono::milliseconds timeout);
+
+private:
+    std::mutex mutex;
+    FlatMap<GameId, std::shared_ptr<Channel>> channels;
+};
+
+#endif //LUDO_GAME_GAMEFEED_H
@@ -1,45 +1,311 @@
 #include "GameManager.h"
+#include <algorithm>
+#include <bit>
+#include "Metrics.h"
+#include <limits>
 #include <random>
-#include <sstream>
+#include <vector>
 
-GameManager::GameManager() {}
+namespace {
+    // Shard lock waits on the request path; the reaper's own locking is not counted
+    Metrics::Histogram& lockWait() { return Metrics::engine().managerLockWait; }
 
-std::string GameManager::generateGameId() {
-    static const char alphanum[] = "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ";
-    std::random_device rd;
-    std::mt19937 gen(rd());
-    std::uniform_int_distribution<> dis(0, sizeof(alphanum) - 2);
+    constexpr GameId ID_MASK = (GameId(1) << GameManager::ID_BITS) - 1;
+    constexpr char DIGITS[] = "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ";
 
-    std::string id;
-    for (int i = 0; i < 6; ++i) id += alphanum[dis(gen)];
-    return id;
+    // ID permutation: a balanced Feistel network over two 18-bit halves
+    constexpr int HALF_BITS = GameManager::ID_BITS / 2;
+    constexpr uint64_t HALF_MASK = (uint64_t(1) << HALF_BITS) - 1;
+    constexpr int FEISTEL_ROUNDS = 4; // Luby-Rackoff: four rounds of a PRF give a strong PRP
+
+    // SipHash-2-4 of one 64-bit word, the keyed round function
+    uint64_t sipHash(const std::array<uint64_t, 2>& key, uint64_t m) {
+        uint64_t v0 = key[0] ^ 0x736f6d6570736575ull, v1 = key[1] ^ 0x646f72616e646f6dull;
+        uint64_t v2 = key[0] ^ 0x6c7967656e657261ull, v3 = key[1] ^ 0x7465646279746573ull;
+        auto round = [&] {
+            v0 += v1; v1 = std::rotl(v1, 13); v1 ^= v0; v0 = std::rotl(v0, 32);
+            v2 += v3; v3 = std::rotl(v3, 16); v3 ^= v2;
+            v0 += v3; v3 = std::rotl(v3, 21); v3 ^= v0;
+            v2 += v1; v1 = std::rotl(v1, 17); v1 ^= v2; v2 = std::rotl(v2, 32);
+        };
+        auto block = [&](uint64_t b) {
+            v3 ^= b;
+            round();
+            round();
+            v0 ^= b;
+        };
+        block(m);
+        block(uint64_t(8) << 56); // Final block: message length 8, no tail bytes
+        v2 ^= 0xff;
+        for (int i = 0; i < 4; i++) round();
+        return v0 ^ v1 ^ v2 ^ v3;
+    }
+
+    uint64_t randomWord(std::random_device& device) { return uint64_t(device()) << 32 | device(); }
+
+    uint64_t randomSeed() {
+        std::random_device device;
+        return randomWord(device);
+    }
+
+    std::array<uint64_t, 2> randomKey() {
+        std::random_device device;
+        return {randomWord(device), randomWord(device)};
+    }
+
+    std::array<uint64_t, 2> keyFromSeed(uint64_t seed) {
+        uint64_t state = seed ^ 0x47414D454944ull; // "GAMEID"
+        return {Ludo::splitmix64(state), Ludo::splitmix64(state)};
+    }
+}
+
+// The ID key is drawn separately from the seed: game seeds are derived from the seed, and
+// those must not lead back to the key
+GameManager::GameManager() : GameManager(randomSeed(), randomKey()) {}
+
+GameManager::GameManager(uint64_t seed) : GameManager(seed, keyFromSeed(seed)) {}
+
+GameManager::GameManager(uint64_t seed, const std::array<uint64_t, 2>& idKey) : seed(seed), idKey(idKey) {}
+
+GameManager::~GameManager() {
+    {
+        std::lock_guard<std::mutex> lock(reaperMutex);
+        stopping = true;
+    }
+    reaperWake.notify_all();
+    if (reaper.joinable()) reaper.join();
 }
 
-std::string GameManager::createGame() {
-    std::lock_guard<std::mutex> lock(managerMutex);
-    std::string id = generateGameId();
-    while (games.find(id) != games.end()) {
-        id = generateGameId();
-    }
-    
-    auto newGame = std::make_shared<Game>();
-    // Pre-populate with 4 players
-    newGame->addPlayer(Player(0, "Green", "#2ecc71", false));
-    newGame->addPlayer(Player(1, "Red", "#e74c3c", false));
-    newGame->addPlayer(Player(2, "Blue", "#3498db", false));
-    newGame->addPlayer(Player(3, "Yellow", "#f1c40f", false));
-    
-    games[id] = newGame;
+GameId GameManager::scramble(uint64_t n) const {
+    // Each round is invertible whatever the round function, so distinct sequence numbers give
+    // distinct IDs. The key enters every round through SipHash, so undoing the rounds, or
+    // relating one ID to another, needs the key.
+    uint64_t left = (n >> HALF_BITS) & HALF_MASK;
+    uint64_t right = n & HALF_MASK;
+    for (int round = 0; round < FEISTEL_ROUNDS; round++) {
+        const uint64_t f = sipHash(idKey, right | uint64_t(round) << HALF_BITS) & HALF_MASK;
+        const uint64_t next = left ^ f;
+        left = right;
+        right = next;
+    }
+    return (left << HALF_BITS | right) & ID_MASK;
+}
+
+std::shared_ptr<Game> GameManager::buildGame(int numPlayers) {
+    static const Player SEATS[Ludo::MAX_PLAYERS] = {
+        Player(0, "Green", "#2ecc71", false),
+        Player(1, "Red", "#e74c3c", false),
+        Player(2, "Blue", "#3498db", false),
+        Player(3, "Yellow", "#f1c40f", false)
+    };
+
+    std::shared_ptr<Game> game = Game::create(numPlayers, 0); // Reseeded when handed out
+    // Pre-populate every seat
+    for (int seat = 0; seat < numPlayers; seat++) game->addPlayer(SEATS[seat]);
+    return game;
+}
+
+std::shared_ptr<Game> GameManager::takeGame(int numPlayers) {
+    Pool& pool = pools[numPlayers];
+    {
+        std::lock_guard<std::mutex> lock(pool.mutex);
+        if (!pool.games.empty()) {
+            std::shared_ptr<Game> game = std::move(pool.games.back());
+            pool.games.pop_back();
+            return game;
+        }
+    }
+    return buildGame(numPlayers); // Pool dry: pay for a new object and its players
+}
+
+void GameManager::recycle(std::shared_ptr<Game> game) {
+    // Still referenced by an in-flight request: let the last holder free it instead
+    if (!game || game.use_count() != 1) return;
+    Pool& pool = pools[game->getNumPlayers()];
+    std::lock_guard<std::mutex> lock(pool.mutex);
+    if (pool.games.size() < POOL_LIMIT) pool.games.push_back(std::move(game));
+}
+
+void GameManager::warmPool(size_t fourPlayerGames) {
+    warmTarget.store(std::min(fourPlayerGames, POOL_LIMIT), std::memory_order_relaxed);
+    refillPool();
+    if (fourPlayerGames > 0) startReaper(); // Tops the stock up even with eviction off
+}
+
+void GameManager::refillPool() {
+    Pool& pool = pools[Ludo::MAX_PLAYERS];
+    const size_t target = warmTarget.load(std::memory_order_relaxed);
+    for (;;) {
+        {
+            std::lock_guard<std::mutex> lock(pool.mutex);
+            if (pool.games.size() >= target) return;
+        }
+        // Built outside the pool lock so createGame is never held up by a refill
+        std::shared_ptr<Game> game = buildGame(Ludo::MAX_PLAYERS);
+        std::lock_guard<std::mutex> lock(pool.mutex);
+        pool.games.push_back(std::move(game));
+    }
+}
+
+size_t GameManager::pooledGames() {
+    size_t total = 0;
+    for (Pool& pool : pools) {
+        std::lock_guard<std::mutex> lock(pool.mutex);
+        total += pool.games.size();
+    }
+    return total;
+}
+
+GameId GameManager::createGame(int numPlayers) {
+    if (numPlayers < 2 || numPlayers > Ludo::MAX_PLAYERS) return NO_GAME;
+    const uint64_t n = sequence.fetch_add(1, std::memory_order_relaxed);
+    uint64_t state = seed + n; // The n-th game's dice depend only on the manager seed and n
+    const GameId id = scramble(n);
+    std::shared_ptr<Game> newGame = takeGame(numPlayers);
+    newGame->reseed(Ludo::splitmix64(state), id);
+
+    const int64_t now = tick.load(std::memory_order_relaxed);
+    newGame->touch(now);
+    const int64_t check = policy.enabled() ? nextCheck(*newGame, now) : 0;
+
+    Shard& shard = shardFor(id);
+    auto lock = Metrics::lockTimed<std::unique_lock<std::shared_mutex>>(shard.mutex, lockWait());
+    shard.games.insert(id, std::move(newGame));
+    if (policy.enabled()) shard.expiry.schedule(id, check);
+    active.fetch_add(1, std::memory_order_relaxed);
     return id;
 }
 
-std::shared_ptr<Game> GameManager::getGame(const std::string& gameId) {
-    std::lock_guard<std::mutex> lock(managerMutex);
-    auto it = games.find(gameId);
-    return (it != games.end()) ? it->second : nullptr;
+std::shared_ptr<Game> GameManager::getGame(GameId gameId) {
+    Shard& shard = shardFor(gameId);
+    auto lock = Metrics::lockTimed<std::shared_lock<std::shared_mutex>>(shard.mutex, lockWait());
+    const std::shared_ptr<Game>* game = shard.games.find(gameId);
+    if (!game) return nullptr;
+    (*game)->touch(tick.load(std::memory_order_relaxed));
+    return *game;
+}
+
+bool GameManager::removeGame(GameId gameId) {
+    Shard& shard = shardFor(gameId);
+    std::shared_ptr<Game> game;
+    {
+        auto lock = Metrics::lockTimed<std::unique_lock<std::shared_mutex>>(shard.mutex, lockWait());
+        std::shared_ptr<Game>* entry = shard.games.find(gameId);
+        if (!entry) return false;
+        game = std::move(*entry);
+        shard.games.erase(gameId); // Its expiry timer, if any, finds nothing and lapses
+    }
+    active.fetch_sub(1, std::memory_order_relaxed);
+    recycle(std::move(game));
+    return true;
+}
+
+int64_t GameManager::nextCheck(const Game& game, int64_t now) const {
+    const int64_t last = game.lastTouched();
+    int64_t deadline = std::numeric_limits<int64_t>::max();
+    if (policy.idleTtl.count() > 0) deadline = last + policy.idleTtl.count();
+    if (policy.finishedTtl.count() > 0) {
+        const bool finished = game.getGameStateEnum() == Game::State::GAME_OVER;
+        // A game still in play is looked at again within finishedTtl in case it ends
+        deadline = std::min(deadline, (finished ? last : now) + policy.finishedTtl.count());
+    }
+    return deadline;
+}
+
+void GameManager::startEviction(EvictionPolicy evictionPolicy) {
+    {
+        // The reaper may already be running for warmPool; it reads the policy under this lock
+        std::lock_guard<std::mutex> lock(reaperMutex);
+        policy = evictionPolicy;
+    }
+    if (!policy.enabled()) return;
+    // Games created before now get their first check on the next pass
+    const int64_t now = tick.load(std::memory_order_relaxed);
+    for (Shard& shard : shards) {
+        std::unique_lock<std::shared_mutex> lock(shard.mutex);
+        shard.games.forEach([&](GameId id, const std::shared_ptr<Game>&) { shard.expiry.schedule(id, now); });
+    }
+    startReaper();
+}
+
+void GameManager::startReaper() {
+    if (!reaper.joinable()) reaper = std::thread(&GameManager::reaperLoop, this);
+}
+
+void GameManager::reaperLoop() {
+    std::unique_lock<std::mutex> lock(reaperMutex);
+    while (!reaperWake.wait_for(lock, std::chrono::seconds(1), [this] { return stopping; })) {
+        const auto elapsed = std::chrono::steady_clock::now() - epoch;
+        const bool evict = policy.enabled();
+        lock.unlock();
+        if (evict) evictExpired(std::chrono::duration_cast<std::chrono::seconds>(elapsed).count());
+        refillPool();
+        lock.lock();
+    }
 }
 
-bool GameManager::removeGame(const std::string& gameId) {
-    std::lock_guard<std::mutex> lock(managerMutex);
-    return games.erase(gameId) > 0;
+size_t GameManager::evictExpired(int64_t now) {
+    tick.store(std::max(now, tick.load(std::memory_order_relaxed)), std::memory_order_relaxed);
+    size_t count = 0;
+    std::vector<GameId> due;
+    std::vector<std::shared_ptr<Game>> dropped; // Recycled after the shard lock is released
+    for (Shard& shard : shards) {
+        due.clear();
+        {
+            std::unique_lock<std::shared_mutex> lock(shard.mutex);
+            shard.expiry.advance(now, [&](uint64_t id) { due.push_back(id); });
+        }
+        for (GameId id : due) {
+            std::shared_ptr<Game> game;
+            {
+                std::shared_lock<std::shared_mutex> lock(shard.mutex);
+                if (const std::shared_ptr<Game>* found = shard.games.find(id)) game = *found;
+            }
+            if (!game) continue; // Removed since the timer was set
+            // nextCheck reads the phase under the game's own lock; no shard lock is held here
+            const int64_t last = game->lastTouched();
+            const int64_t deadline = nextCheck(*game, now);
+
+            std::unique_lock<std::shared_mutex> lock(shard.mutex);
+            std::shared_ptr<Game>* entry = shard.games.find(id);
+            if (!entry || *entry != game) continue;
+            if (deadline > now || game->lastTouched() != last) {
+                shard.expiry.schedule(id, std::max(deadline, now + 1));
+                continue;
+            }
+            dropped.push_back(std::move(*entry));
+            shard.games.erase(id);
+            count++;
+        }
+        for (std::shared_ptr<Game>& game : dropped) recycle(std::move(game));
+        dropped.clear();
+    }
+    evicted.fetch_add(count, std::memory_order_relaxed);
+    active.fetch_sub(count, std::memory_order_relaxed);
+    return count;
+}
+
+GameManager::Stats GameManager::stats() const {
+    return {active.load(std::memory_order_relaxed), sequence.load(std::memory_order_relaxed),
+            evicted.load(std::memory_order_relaxed)};
+}
+
+std::string GameManager::formatId(GameId gameId) {
+    std::string text(ID_CHARS, '0');
+    for (int i = ID_CHARS - 1; i >= 0 && gameId; i--, gameId /= 36) text[i] = DIGITS[gameId % 36];
+    return text;
+}
+
+GameId GameManager::parseId(std::string_view text) {
+    if (text.empty() || text.size() > ID_CHARS) return NO_GAME;
+    GameId id = 0;
+    for (char c : text) {
+        int digit;
+        if (c >= '0' && c <= '9') digit = c - '0';
+        else if (c >= 'A' && c <= 'Z') digit = c - 'A' + 10;
+        else if (c >= 'a' && c <= 'z') digit = c - 'a' + 10;
+        else return NO_GAME;
+        id = id * 36 + digit;
+    }
+    return id <= ID_MASK ? id : NO_GAME;
 }
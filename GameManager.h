@@ -1,31 +1,133 @@
 #ifndef GAMEMANAGER_H
 #define GAMEMANAGER_H
 
-#include <map>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
 #include <string>
+#include <string_view>
 #include <memory>
 #include <mutex>
+#include <shared_mutex>
+#include <thread>
+#include <vector>
+#include "FlatMap.h"
 #include "Game.h"
+#include "TimingWheel.h"
+
+// Games are keyed by a 36-bit integer ID: a creation sequence number run through a keyed
+// pseudorandom permutation, so IDs are unique without collision checks, and one ID tells
+// nothing about any other without the key.
+// They appear as 7 base36 characters only at the API edge (formatId / parseId).
+using GameId = uint64_t;
+
+// Idle eviction: a game nobody has looked up for idleTtl is removed, and a finished one
+// after finishedTtl. Zero disables that rule.
+struct EvictionPolicy {
+    std::chrono::seconds idleTtl{0};
+    std::chrono::seconds finishedTtl{0};
+
+    bool enabled() const { return idleTtl.count() > 0 || finishedTtl.count() > 0; }
+};
 
 class GameManager {
 private:
-    std::map<std::string, std::shared_ptr<Game>> games;
-    std::mutex managerMutex; // Protect access to the map
+    // The registry is striped over SHARDS independently locked maps picked by ID bits, so
+    // lookups of different games rarely touch the same lock, and getGame only takes it shared
+    static constexpr size_t SHARDS = 64;
+
+    struct alignas(64) Shard { // One cache line per lock: no false sharing between shards
+        std::shared_mutex mutex;
+        FlatMap<GameId, std::shared_ptr<Game>> games;
+        TimingWheel expiry; // One pending check per game while eviction is on, in ticks
+    };
+
+    std::array<Shard, SHARDS> shards;
+    const uint64_t seed;                 // Game seeds derive from it
+    const std::array<uint64_t, 2> idKey; // Key of the ID permutation
+    std::atomic<uint64_t> sequence{0};   // Games created so far
+    std::atomic<uint64_t> evicted{0};
+    std::atomic<uint64_t> active{0};
+
+    // Spare games per seat count (index 2-4) with every seat filled: removed and evicted
+    // games are recycled here, and warmPool keeps a stock of 4-player ones. createGame
+    // takes one in O(1) and reseeds it, so the usual path builds no Game and no Players.
+    static constexpr size_t POOL_LIMIT = 4096; // Per seat count; extra returns are freed
+    struct Pool {
+        std::mutex mutex;
+        std::vector<std::shared_ptr<Game>> games;
+    };
+    std::array<Pool, Ludo::MAX_PLAYERS + 1> pools;
+    std::atomic<size_t> warmTarget{0};
+
+    // Eviction clock in whole seconds since construction, advanced by the reaper thread
+    const std::chrono::steady_clock::time_point epoch = std::chrono::steady_clock::now();
+    std::atomic<int64_t> tick{0};
+    EvictionPolicy policy;
+    std::thread reaper;
+    std::mutex reaperMutex;
+    std::condition_variable reaperWake;
+    bool stopping = false;
     
-    // Helper to generate IDs
-    std::string generateGameId();
+    GameManager(uint64_t seed, const std::array<uint64_t, 2>& idKey);
+    GameId scramble(uint64_t n) const;
+    Shard& shardFor(GameId gameId) { return shards[gameId & (SHARDS - 1)]; }
+    int64_t nextCheck(const Game& game, int64_t now) const;
+    static std::shared_ptr<Game> buildGame(int numPlayers);
+    std::shared_ptr<Game> takeGame(int numPlayers);
+    void recycle(std::shared_ptr<Game> game);
+    void refillPool();
+    void startReaper(); // Once, from startEviction or warmPool: both are setup calls
+    void reaperLoop();
 
 public:
-    GameManager();
+    static constexpr int ID_BITS = 36;
+    static constexpr int ID_CHARS = 7; // 36^7 > 2^36
+    static constexpr GameId NO_GAME = ~GameId(0); // Outside the ID space; never registered
+
+    struct Stats {
+        uint64_t active;
+        uint64_t created;
+        uint64_t evicted;
+    };
+
+    GameManager(); // Seed and ID key from std::random_device
+    // Fixed seed: the same requests replay the same games and IDs. The ID key derives from
+    // the seed, so anyone who knows it can compute every ID; for tests and replays.
+    explicit GameManager(uint64_t seed);
+    ~GameManager();
     
-    // Create a new game and return its ID
-    std::string createGame();
+    // Create a new game with 2-4 seated players and return its ID (NO_GAME for a bad count)
+    GameId createGame(int numPlayers = 4);
     
-    // Get a game instance by ID (thread-safe retrieval)
-    std::shared_ptr<Game> getGame(const std::string& gameId);
+    // Get a game instance by ID (thread-safe retrieval); counts as activity
+    std::shared_ptr<Game> getGame(GameId gameId);
     
     // Remove a game (e.g., when finished)
-    bool removeGame(const std::string& gameId);
+    bool removeGame(GameId gameId);
+
+    // Evict games per `policy` from the background reaper, which wakes once a second.
+    // Call once, before serving requests.
+    void startEviction(EvictionPolicy evictionPolicy);
+
+    // One reaper pass at eviction tick `now` (seconds since construction); returns the
+    // number of games evicted. The reaper thread calls this; exposed for tools.
+    size_t evictExpired(int64_t now);
+
+    // Build `fourPlayerGames` ready 4-player games now; the background reaper tops the
+    // stock back up each second as createGame draws it down, with or without eviction.
+    // Call before serving requests.
+    void warmPool(size_t fourPlayerGames);
+    size_t pooledGames();
+
+    Stats stats() const;
+
+    // Base36 text form used in URLs and responses; parseId accepts either case and
+    // returns NO_GAME for anything that is not a valid ID
+    static std::string formatId(GameId gameId);
+    static GameId parseId(std::string_view text);
 };
 
 #endif // GAMEMANAGER_H
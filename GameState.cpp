@@ -0,0 +1,214 @@
+#include "GameState.h"
+#include "Zobrist.h"
+#include <bit>
+#include <cassert>
+
+// Debug builds recompute the key after every mutation so incremental drift fails fast
+#ifndef NDEBUG
+#define LUDO_CHECK_HASH(state) assert((state).hash == computeHash(state))
+#else
+#define LUDO_CHECK_HASH(state) ((void)0)
+#endif
+
+namespace Ludo {
+    namespace {
+        template <Position S>
+        void passTurn(S& state) {
+            int8_t next = state.currentPlayer + 1;
+            next = next == state.numPlayers ? 0 : next;
+            state.hash ^= Zobrist::side(state.currentPlayer) ^ Zobrist::side(next);
+            state.currentPlayer = next;
+            state.phase = Phase::WAITING_FOR_ROLL;
+        }
+
+        // Pieces of one seat standing at `progress`, as a mask with bit i = piece i. The four
+        // progress bytes are tested as one word: after the XOR a matching piece is a zero byte.
+        uint32_t piecesAt(const std::array<int8_t, MAX_PIECES>& pieces, int8_t progress) {
+            static_assert(MAX_PIECES == 4 && std::endian::native == std::endian::little);
+            const uint32_t word = std::bit_cast<uint32_t>(pieces) ^ (uint8_t(progress) * 0x01010101u);
+            const uint32_t zero = ~(((word & 0x7F7F7F7Fu) + 0x7F7F7F7Fu) | word | 0x7F7F7F7Fu);
+            // Flags sit at bits 7, 15, 23 and 31; the multiply gathers them into bits 21-24
+            return (zero >> 7) * 0x00204081u >> 21 & 0xF;
+        }
+
+        template <Position S>
+        void setProgress(S& state, int8_t playerIdx, int8_t pieceIdx, int8_t progress) {
+            int8_t& prog = state.progress[playerIdx][pieceIdx];
+            state.hash ^= Zobrist::piece(playerIdx, pieceIdx, prog) ^ Zobrist::piece(playerIdx, pieceIdx, progress);
+            prog = progress;
+        }
+    }
+
+    template <Position S>
+    uint64_t computeHash(const S& state) {
+        uint64_t hash = Zobrist::side(state.currentPlayer) ^ Zobrist::players(state.numPlayers);
+        for (int8_t p = 0; p < state.numPlayers; p++) {
+            for (int8_t i = 0; i < MAX_PIECES; i++) hash ^= Zobrist::piece(p, i, state.progress[p][i]);
+        }
+        if (state.phase == Phase::WAITING_FOR_MOVE) hash ^= Zobrist::roll(state.roll);
+        return hash;
+    }
+
+    GameState makeGameState(int8_t numPlayers) {
+        GameState state{};
+        for (auto& pieces : state.progress) pieces.fill(-1);
+        state.numPlayers = numPlayers;
+        state.currentPlayer = 0;
+        state.roll = 0;
+        state.phase = numPlayers >= 2 ? Phase::WAITING_FOR_ROLL : Phase::WAITING_FOR_PLAYERS;
+        state.winner = -1;
+        state.hash = computeHash(state);
+        return state;
+    }
+
+    template <int Players>
+    FixedGameState<Players> makeFixedGameState() {
+        FixedGameState<Players> state{};
+        for (auto& pieces : state.progress) pieces.fill(-1);
+        state.currentPlayer = 0;
+        state.roll = 0;
+        state.phase = Phase::WAITING_FOR_ROLL;
+        state.winner = -1;
+        state.hash = computeHash(state);
+        return state;
+    }
+
+    template <int Players>
+    GameState toGameState(const FixedGameState<Players>& state) {
+        GameState wide = makeGameState(Players);
+        for (int p = 0; p < Players; p++) wide.progress[p] = state.progress[p];
+        wide.currentPlayer = state.currentPlayer;
+        wide.roll = state.roll;
+        wide.phase = state.phase;
+        wide.winner = state.winner;
+        wide.hash = state.hash;
+        return wide;
+    }
+
+    template <Position S>
+    Occupancy occupancy(const S& state) {
+        Occupancy occ;
+        for (int8_t p = 0; p < state.numPlayers; p++) {
+            for (int8_t prog : state.progress[p]) {
+                if (prog >= 0) occ.seat[p] |= squareBit(squareOf(p, prog));
+            }
+        }
+        return occ;
+    }
+
+    template <Position S>
+    bool hasLegalMove(const S& state, int8_t playerIdx, int8_t roll) {
+        for (int8_t prog : state.progress[playerIdx]) {
+            if (canMovePiece(prog, roll)) return true;
+        }
+        return false;
+    }
+
+    template <Position S>
+    bool isLegalMove(const S& state, int8_t pieceIdx) {
+        if (state.phase != Phase::WAITING_FOR_MOVE) return false;
+        if (pieceIdx < 0 || pieceIdx >= MAX_PIECES) return false;
+        return canMovePiece(state.progress[state.currentPlayer][pieceIdx], state.roll);
+    }
+
+    template <Position S>
+    void applyRoll(S& state, int8_t roll) {
+        state.roll = roll;
+        if (hasLegalMove(state, state.currentPlayer, roll)) {
+            state.phase = Phase::WAITING_FOR_MOVE;
+            state.hash ^= Zobrist::roll(roll);
+        } else {
+            passTurn(state);
+        }
+        LUDO_CHECK_HASH(state);
+    }
+
+    template <Position S>
+    UndoRecord applyMove(S& state, int8_t pieceIdx) {
+        const int8_t mover = state.currentPlayer;
+        const int8_t from = state.progress[mover][pieceIdx];
+        UndoRecord undo{0, mover, pieceIdx, from, state.roll, state.phase, state.winner};
+
+        // The roll is consumed by this move
+        state.hash ^= Zobrist::roll(state.roll);
+
+        // Spawning lands on progress 0; a roll of 6 from base is consumed by the spawn
+        const int8_t prog = static_cast<int8_t>(nextProgress(from, state.roll));
+        setProgress(state, mover, pieceIdx, prog);
+
+        // Captures: each opponent is tested at the one progress value that puts a piece on the
+        // landing square, with no occupancy rebuild and no per-piece square lookups
+        if (prog < TRACK_SIZE) {
+            const int square = globalSquare(mover, prog);
+            if (!isSafeTrackIndex(square)) {
+                for (int8_t other = 0; other < state.numPlayers; other++) {
+                    if (other == mover) continue;
+                    uint32_t hit = piecesAt(state.progress[other], static_cast<int8_t>(trackProgress(other, square)));
+                    undo.captured |= uint16_t(hit << (other * MAX_PIECES));
+                    for (; hit; hit &= hit - 1) setProgress(state, other, static_cast<int8_t>(std::countr_zero(hit)), -1);
+                }
+            }
+        }
+
+        // Only the mover can have just finished
+        bool allHome = true;
+        for (int8_t p : state.progress[mover]) allHome &= (p == HOME_PROGRESS);
+        if (allHome) {
+            state.winner = mover;
+            state.phase = Phase::GAME_OVER;
+        } else if (state.roll == 6) {
+            state.phase = Phase::WAITING_FOR_ROLL; // Same player rolls again
+        } else {
+            passTurn(state);
+        }
+        LUDO_CHECK_HASH(state);
+        return undo;
+    }
+
+    template <Position S>
+    void undoMove(S& state, const UndoRecord& undo) {
+        if (undo.captured) {
+            const int square = globalSquare(undo.player, state.progress[undo.player][undo.piece]);
+            for (int8_t other = 0; other < state.numPlayers; other++) {
+                const int otherProg = trackProgress(other, square);
+                for (int8_t i = 0; i < MAX_PIECES; i++) {
+                    if (undo.captured & (1u << (other * MAX_PIECES + i))) {
+                        setProgress(state, other, i, static_cast<int8_t>(otherProg));
+                    }
+                }
+            }
+        }
+        setProgress(state, undo.player, undo.piece, undo.from);
+
+        state.hash ^= Zobrist::side(state.currentPlayer) ^ Zobrist::side(undo.player);
+        if (state.phase == Phase::WAITING_FOR_MOVE) state.hash ^= Zobrist::roll(state.roll);
+        if (undo.phase == Phase::WAITING_FOR_MOVE) state.hash ^= Zobrist::roll(undo.roll);
+        state.currentPlayer = undo.player;
+        state.roll = undo.roll;
+        state.phase = undo.phase;
+        state.winner = undo.winner;
+        LUDO_CHECK_HASH(state);
+    }
+
+#define LUDO_INSTANTIATE_RULES(S)                                               \
+    template uint64_t computeHash(const S&);                                    \
+    template Occupancy occupancy(const S&);                                     \
+    template bool hasLegalMove(const S&, int8_t, int8_t);                       \
+    template bool isLegalMove(const S&, int8_t);                                \
+    template void applyRoll(S&, int8_t);                                        \
+    template UndoRecord applyMove(S&, int8_t);                                  \
+    template void undoMove(S&, const UndoRecord&);
+
+    LUDO_INSTANTIATE_RULES(GameState)
+    LUDO_INSTANTIATE_RULES(FixedGameState<2>)
+    LUDO_INSTANTIATE_RULES(FixedGameState<3>)
+    LUDO_INSTANTIATE_RULES(FixedGameState<4>)
+#undef LUDO_INSTANTIATE_RULES
+
+    template FixedGameState<2> makeFixedGameState<2>();
+    template FixedGameState<3> makeFixedGameState<3>();
+    template FixedGameState<4> makeFixedGameState<4>();
+    template GameState toGameState(const FixedGameState<2>&);
+    template GameState toGameState(const FixedGameState<3>&);
+    template GameState toGameState(const FixedGameState<4>&);
+}
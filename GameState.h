@@ -0,0 +1,136 @@
+#ifndef LUDO_GAME_GAMESTATE_H
+#define LUDO_GAME_GAMESTATE_H
+
+#include <array>
+#include <concepts>
+#include <cstdint>
+#include <type_traits>
+#include "Constants.h"
+#include "Bitboard.h"
+
+namespace Ludo {
+    enum class Phase : int8_t {
+        WAITING_FOR_PLAYERS,
+        WAITING_FOR_ROLL,
+        WAITING_FOR_MOVE,
+        GAME_OVER
+    };
+
+    // A complete position as a plain value: no heap, no locks, no names.
+    // Cheap enough to copy per search node and to store by the million.
+    struct GameState {
+        // Zobrist key of everything below that matters for play: progress, seat count, side to
+        // move and the pending roll. Kept up to date incrementally by the functions in this header.
+        uint64_t hash;
+        // progress: -1 (base), 0-51 (track), 52-56 (home stretch), 57 (home)
+        std::array<std::array<int8_t, MAX_PIECES>, MAX_PLAYERS> progress;
+        int8_t numPlayers;
+        int8_t currentPlayer;
+        int8_t roll;      // Last roll; pending while phase == WAITING_FOR_MOVE
+        Phase phase;
+        int8_t winner;    // Seat index, -1 until GAME_OVER
+    };
+
+    // The same position with the seat count in the type: every loop over players has a
+    // constant trip count, and only the seats in play are stored. Used by Game<Players>.
+    template <int Players>
+    struct FixedGameState {
+        static_assert(Players >= 2 && Players <= MAX_PLAYERS, "Ludo is played by 2-4 players");
+        static constexpr int8_t numPlayers = Players;
+
+        uint64_t hash;
+        std::array<std::array<int8_t, MAX_PIECES>, Players> progress;
+        int8_t currentPlayer;
+        int8_t roll;
+        Phase phase;
+        int8_t winner;
+    };
+
+    static_assert(std::is_trivially_copyable_v<GameState>, "GameState must stay a plain value");
+    static_assert(sizeof(GameState) <= 32, "GameState must fit in half a cache line");
+    static_assert(std::is_trivially_copyable_v<FixedGameState<2>>, "FixedGameState must stay a plain value");
+    static_assert(sizeof(FixedGameState<2>) == 24, "A 1v1 position stores half the progress bytes");
+
+    // Either position type; the rule functions below are instantiated for all of them
+    template <class S>
+    concept Position = std::same_as<S, GameState> || std::same_as<S, FixedGameState<2>> ||
+                       std::same_as<S, FixedGameState<3>> || std::same_as<S, FixedGameState<4>>;
+
+    constexpr int8_t HOME_PROGRESS = TOTAL_PROGRESS_STEPS - 1; // 57
+
+    // A piece at `progress` can use `roll`: spawn needs a 6, and home must not be overshot.
+    constexpr bool canMovePiece(int8_t progress, int8_t roll) { return nextProgress(progress, roll) >= 0; }
+
+    // Fresh position with every piece in base.
+    GameState makeGameState(int8_t numPlayers);
+
+    template <int Players>
+    FixedGameState<Players> makeFixedGameState();
+
+    // Widen to the runtime-count layout used by search and simulation; the hash carries over
+    // because seats that do not exist hold base pieces, which hash to zero.
+    template <int Players>
+    GameState toGameState(const FixedGameState<Players>& state);
+
+    // Full Zobrist recompute. The incremental key must always equal this.
+    template <Position S>
+    uint64_t computeHash(const S& state);
+
+    // Per-seat occupancy bitboards (see Bitboard.h). Four masks do not fit the 32-byte
+    // position, so move generation builds them once per node and flags every candidate
+    // move with mask tests. applyMove needs only the landing square and tests it directly.
+    struct Occupancy {
+        std::array<Bitboard, MAX_PLAYERS> seat{}; // Seats not in play stay empty
+
+        // Shared-track squares off the safe spots held by anyone but `mover`
+        constexpr Bitboard capturable(int8_t mover) const {
+            Bitboard mask = 0;
+            for (int8_t p = 0; p < MAX_PLAYERS; p++) {
+                if (p != mover) mask |= seat[p];
+            }
+            return mask & TRACK_SQUARES & ~SAFE_SQUARES;
+        }
+    };
+
+    template <Position S>
+    Occupancy occupancy(const S& state);
+
+    template <Position S>
+    bool hasLegalMove(const S& state, int8_t playerIdx, int8_t roll);
+
+    // Is moving `pieceIdx` of the current player with the pending roll legal?
+    template <Position S>
+    bool isLegalMove(const S& state, int8_t pieceIdx);
+
+    // Record a roll: waits for a move, or passes the turn when nothing can move.
+    template <Position S>
+    void applyRoll(S& state, int8_t roll);
+
+    // Everything applyMove overwrites, so undoMove can restore the position exactly.
+    // Captured pieces all sat on the mover's landing square, so their progress is implied.
+    struct UndoRecord {
+        uint16_t captured; // Bit = seat * MAX_PIECES + piece
+        int8_t player;
+        int8_t piece;
+        int8_t from;
+        int8_t roll;
+        Phase phase;
+        int8_t winner;
+    };
+
+    static_assert(sizeof(UndoRecord) == 8, "UndoRecord should stay a single word");
+
+    // Move a piece with the pending roll and advance the turn.
+    // Precondition: isLegalMove(state, pieceIdx).
+    template <Position S>
+    UndoRecord applyMove(S& state, int8_t pieceIdx);
+
+    // Reverse the applyMove that produced `undo`. Moves must be undone in LIFO order.
+    template <Position S>
+    void undoMove(S& state, const UndoRecord& undo);
+
+    template <Position S>
+    bool isTerminal(const S& state) { return state.phase == Phase::GAME_OVER; }
+}
+
+#endif //LUDO_GAME_GAMESTATE_H
@@ -0,0 +1,224 @@
+#include "Mcts.h"
+#include "Expectimax.h"
+#include "Random.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+
+using namespace Ludo;
+
+namespace {
+    constexpr uint64_t REWARD_ONE = 1 << 16; // Rewards are summed in 16.16 fixed point
+    constexpr int TIME_CHECK_INTERVAL = 16;  // Iterations between clock reads
+
+    enum Expansion : uint8_t {
+        UNEXPANDED,
+        EXPANDING, // Claimed by a thread, or permanently a leaf once the arena is full
+        EXPANDED
+    };
+}
+
+struct Mcts::Node {
+    std::atomic<uint32_t> visits{0};  // Includes virtual loss while threads are below this node
+    std::atomic<uint64_t> reward{0};  // Fixed point, credited to `mover`
+    std::atomic<uint8_t> expansion{UNEXPANDED};
+    uint8_t childCount = 0;           // Published by the release store of `expansion`
+    int8_t move = -1;                 // Piece for decision edges, die face for chance edges
+    int8_t mover = -1;                // Player who chose this edge; -1 for dice outcomes
+    Node* children = nullptr;
+};
+
+struct Mcts::Tree {
+    Arena arena;
+    Node* root = nullptr;
+
+    explicit Tree(size_t bytes) : arena(bytes) {}
+};
+
+using Node = Mcts::Node;
+
+Mcts::Mcts(const Config& cfg) : Mcts(nullptr, cfg) {}
+
+Mcts::Mcts(ThreadPool& threadPool, const Config& cfg) : Mcts(&threadPool, cfg) {}
+
+Mcts::Mcts(ThreadPool* threadPool, const Config& cfg) : pool(threadPool), config(cfg) {
+    config.threads = pool ? std::max(1, config.threads) : 1;
+    if (config.seed == 0) config.seed = std::random_device{}();
+
+    const size_t treeCount = config.mode == Parallelism::ROOT ? config.threads : 1;
+    const size_t bytesPerTree = (config.arenaMB << 20) / treeCount;
+    for (size_t i = 0; i < treeCount; i++) trees.push_back(std::make_unique<Tree>(bytesPerTree));
+}
+
+Mcts::~Mcts() = default;
+
+namespace {
+    // Claim and build the children of `node`, or return nullptr if it must stay a leaf for now
+    Node* expand(Node* node, const GameState& state, Arena& arena) {
+        uint8_t status = node->expansion.load(std::memory_order_acquire);
+        if (status == EXPANDED) return node->children;
+        if (status == EXPANDING) return nullptr;
+        if (!node->expansion.compare_exchange_strong(status, EXPANDING, std::memory_order_acquire)) {
+            return status == EXPANDED ? node->children : nullptr;
+        }
+
+        MoveList moves;
+        const bool decision = state.phase == Phase::WAITING_FOR_MOVE;
+        if (decision) generateMoves(state, state.roll, moves);
+        const uint8_t count = decision ? moves.size() : DIE_FACES;
+
+        Node* children = arena.makeArray<Node>(count);
+        if (!children) return nullptr; // Arena full: stays EXPANDING, i.e. a leaf
+        for (uint8_t i = 0; i < count; i++) {
+            children[i].move = decision ? moves[i].piece : static_cast<int8_t>(i + 1);
+            children[i].mover = decision ? state.currentPlayer : -1;
+        }
+        node->children = children;
+        node->childCount = count;
+        node->expansion.store(EXPANDED, std::memory_order_release);
+        return children;
+    }
+
+    Node* selectUct(Node* node, Node* children, float exploration) {
+        const float logParent = std::log(static_cast<float>(std::max<uint32_t>(1, node->visits.load(std::memory_order_relaxed))));
+        Node* best = children;
+        float bestScore = -std::numeric_limits<float>::infinity();
+        for (uint8_t i = 0; i < node->childCount; i++) {
+            Node& child = children[i];
+            const uint32_t n = child.visits.load(std::memory_order_relaxed);
+            if (n == 0) return &child; // Try everything once
+            const float q = float(child.reward.load(std::memory_order_relaxed)) / float(REWARD_ONE) / n;
+            const float score = q + exploration * std::sqrt(logParent / n);
+            if (score > bestScore) {
+                bestScore = score;
+                best = &child;
+            }
+        }
+        return best;
+    }
+
+    // Random playout; returns each player's reward in [0, 1]
+    std::array<float, MAX_PLAYERS> playout(GameState state, Xoshiro256ss& rng, int maxMoves) {
+        std::array<float, MAX_PLAYERS> rewards{};
+        int moves = 0;
+        // Rolls are bounded too, in case every seat keeps passing
+        for (int steps = 0; !isTerminal(state) && moves < maxMoves && steps < 4 * maxMoves; steps++) {
+            if (state.phase == Phase::WAITING_FOR_ROLL) {
+                applyRoll(state, rollDie(rng));
+            } else {
+                MoveList legal;
+                generateMoves(state, state.roll, legal);
+                applyMove(state, legal[uniformBelow(rng, legal.size())].piece);
+                moves++;
+            }
+        }
+        if (isTerminal(state)) {
+            rewards[state.winner] = 1.0f;
+        } else {
+            for (int8_t p = 0; p < state.numPlayers; p++) {
+                rewards[p] = (Expectimax::evaluate(state, p) - Expectimax::LOSS) / (Expectimax::WIN - Expectimax::LOSS);
+            }
+        }
+        return rewards;
+    }
+}
+
+void Mcts::runIterations(Tree& tree, const GameState& root,
+                         std::chrono::steady_clock::time_point deadline, uint64_t seed) {
+    Xoshiro256ss rng(seed);
+    const uint32_t virtualLoss = config.mode == Parallelism::TREE && config.threads > 1 ? config.virtualLoss : 0;
+    std::vector<Node*> path;
+    path.reserve(256);
+
+    for (uint64_t iteration = 0;; iteration++) {
+        if (config.maxIterations && iteration >= config.maxIterations) break;
+        if (iteration % TIME_CHECK_INTERVAL == 0 && std::chrono::steady_clock::now() >= deadline) break;
+
+        // Selection / expansion
+        GameState state = root;
+        Node* node = tree.root;
+        path.clear();
+        path.push_back(node);
+        node->visits.fetch_add(virtualLoss, std::memory_order_relaxed);
+
+        while (!isTerminal(state)) {
+            Node* children = expand(node, state, tree.arena);
+            if (!children) break;
+
+            if (state.phase == Phase::WAITING_FOR_MOVE) {
+                node = selectUct(node, children, config.exploration);
+                applyMove(state, node->move);
+            } else {
+                node = &children[uniformBelow(rng, DIE_FACES)];
+                applyRoll(state, node->move);
+            }
+            path.push_back(node);
+            // First visit to a node: play out from here, expand on the next visit
+            if (node->visits.fetch_add(virtualLoss, std::memory_order_relaxed) == 0) break;
+        }
+
+        // Simulation
+        const auto rewards = playout(state, rng, config.maxPlayoutMoves);
+
+        // Backpropagation: replace the virtual loss with the real visit
+        for (Node* n : path) {
+            n->visits.fetch_add(1 - virtualLoss, std::memory_order_relaxed);
+            if (n->mover >= 0) {
+                n->reward.fetch_add(static_cast<uint64_t>(rewards[n->mover] * REWARD_ONE), std::memory_order_relaxed);
+            }
+        }
+    }
+}
+
+Mcts::Result Mcts::search(const GameState& state, std::chrono::nanoseconds budget) {
+    const auto deadline = std::chrono::steady_clock::now() + budget;
+    Result result{{-1, -1, -1, 0}, 0, 0.0f};
+    if (state.phase != Phase::WAITING_FOR_MOVE) return result;
+
+    MoveList moves;
+    generateMoves(state, state.roll, moves);
+    result.move = moves[0];
+    if (moves.size() == 1) return result; // Forced
+
+    for (auto& tree : trees) {
+        tree->arena.reset();
+        tree->root = tree->arena.makeArray<Node>(1);
+    }
+
+    searches++;
+    const uint64_t baseSeed = config.seed ^ (searches * 0x9E3779B97F4A7C15ull);
+    if (config.threads == 1) {
+        runIterations(*trees[0], state, deadline, baseSeed);
+    } else {
+        for (int t = 0; t < config.threads; t++) {
+            Tree& tree = config.mode == Parallelism::ROOT ? *trees[t] : *trees[0];
+            pool->submit([this, &tree, &state, deadline, seed = baseSeed + t] {
+                runIterations(tree, state, deadline, seed);
+            });
+        }
+        pool->wait();
+    }
+
+    // Merge root statistics; every tree expanded the root with the same move order
+    std::array<uint64_t, MAX_PIECES> visits{};
+    std::array<uint64_t, MAX_PIECES> reward{};
+    for (auto& tree : trees) {
+        Node* root = tree->root;
+        result.iterations += root->visits.load(std::memory_order_relaxed);
+        if (root->expansion.load(std::memory_order_acquire) != EXPANDED) continue;
+        for (uint8_t i = 0; i < root->childCount; i++) {
+            visits[i] += root->children[i].visits.load(std::memory_order_relaxed);
+            reward[i] += root->children[i].reward.load(std::memory_order_relaxed);
+        }
+    }
+
+    // Most visited move is the most robust choice
+    int best = 0;
+    for (int i = 1; i < moves.size(); i++) {
+        if (visits[i] > visits[best]) best = i;
+    }
+    result.move = moves[best];
+    result.winRate = visits[best] ? float(reward[best]) / float(REWARD_ONE) / float(visits[best]) : 0.0f;
+    return result;
+}
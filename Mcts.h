@@ -0,0 +1,67 @@
+#ifndef LUDO_GAME_MCTS_H
+#define LUDO_GAME_MCTS_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "Arena.h"
+#include "GameState.h"
+#include "MoveGen.h"
+#include "ThreadPool.h"
+
+// Monte Carlo Tree Search with explicit chance nodes for the die.
+// Decision nodes pick a child by UCT from the point of view of the player to move;
+// chance nodes sample a face uniformly. Rewards are per player (the winner scores 1),
+// so the same tree works for two to four seats.
+class Mcts {
+public:
+    enum class Parallelism {
+        ROOT, // One private tree per thread, root statistics merged at the end
+        TREE  // One shared tree, threads kept apart by virtual loss
+    };
+
+    struct Config {
+        int threads = 1;
+        Parallelism mode = Parallelism::TREE;
+        size_t arenaMB = 64;       // Node memory per decision, split across trees in ROOT mode
+        float exploration = 1.0f;  // UCT constant
+        int virtualLoss = 3;       // Pending visits added while a thread is below a node
+        int maxPlayoutMoves = 400; // Playouts still running after this are scored heuristically
+        uint64_t maxIterations = 0; // Per thread and decision; 0 = until the budget runs out
+        uint64_t seed = 0;
+    };
+
+    struct Result {
+        Ludo::Move move;    // piece == -1 if nothing can move
+        uint64_t iterations;
+        float winRate;      // Mean reward of the chosen move for the mover
+    };
+
+    Mcts(ThreadPool& pool, const Config& config);
+    explicit Mcts(const Config& config); // Single-threaded: searches on the calling thread
+    ~Mcts();
+
+    // Search a position that is waiting for a move until `budget` runs out.
+    // Node memory from the previous decision is released first.
+    Result search(const Ludo::GameState& state, std::chrono::nanoseconds budget);
+
+    // Defined in Mcts.cpp
+    struct Node;
+    struct Tree;
+
+private:
+
+    ThreadPool* pool; // nullptr when single-threaded
+    Config config;
+    std::vector<std::unique_ptr<Tree>> trees;
+    uint64_t searches = 0;
+
+    Mcts(ThreadPool* pool, const Config& config);
+
+    void runIterations(Tree& tree, const Ludo::GameState& root,
+                       std::chrono::steady_clock::time_point deadline, uint64_t seed);
+};
+
+#endif //LUDO_GAME_MCTS_H
@@ -0,0 +1,70 @@
+#include "Metrics.h"
+#include <bit>
+#include <cstdio>
+
+namespace Metrics {
+    int shard() {
+        static std::atomic<int> next{0};
+        thread_local const int index = next.fetch_add(1, std::memory_order_relaxed) % SHARDS;
+        return index;
+    }
+
+    uint64_t Counter::value() const {
+        uint64_t total = 0;
+        for (const Cell& cell : cells) total += cell.value.load(std::memory_order_relaxed);
+        return total;
+    }
+
+    void Histogram::observe(uint64_t ns) {
+        // Bucket i holds (bound(i-1), bound(i)]: two bits of magnitude per bucket
+        int bucket = ns <= bound(0) ? 0 : (std::bit_width(ns - 1) - 7) / 2;
+        if (bucket > BUCKETS) bucket = BUCKETS;
+        Cell& cell = cells[shard()];
+        cell.counts[bucket].fetch_add(1, std::memory_order_relaxed);
+        cell.sumNs.fetch_add(ns, std::memory_order_relaxed);
+    }
+
+    Histogram::Snapshot Histogram::snapshot() const {
+        Snapshot snap;
+        for (const Cell& cell : cells) {
+            for (int b = 0; b <= BUCKETS; b++) snap.counts[b] += cell.counts[b].load(std::memory_order_relaxed);
+            snap.sumNs += cell.sumNs.load(std::memory_order_relaxed);
+        }
+        for (uint64_t c : snap.counts) snap.count += c;
+        return snap;
+    }
+
+    Engine& engine() {
+        static Engine metrics;
+        return metrics;
+    }
+
+    void Writer::header(std::string_view name, std::string_view help, std::string_view type) {
+        out.append("# HELP ").append(name).append(" ").append(help).append("\n");
+        out.append("# TYPE ").append(name).append(" ").append(type).append("\n");
+    }
+
+    void Writer::sample(std::string_view name, std::string_view labels, double value) {
+        char buf[32];
+        std::snprintf(buf, sizeof(buf), "%.15g", value);
+        out.append(name);
+        if (!labels.empty()) out.append("{").append(labels).append("}");
+        out.append(" ").append(buf).append("\n");
+    }
+
+    void Writer::histogram(std::string_view name, std::string_view labels, const Histogram& histogram) {
+        const Histogram::Snapshot snap = histogram.snapshot();
+        const std::string prefix = labels.empty() ? "" : std::string(labels) + ",";
+        const std::string bucket = std::string(name) + "_bucket";
+        uint64_t cumulative = 0;
+        char le[48];
+        for (int b = 0; b <= Histogram::BUCKETS; b++) {
+            cumulative += snap.counts[b];
+            if (b < Histogram::BUCKETS) std::snprintf(le, sizeof(le), "le=\"%g\"", Histogram::bound(b) * 1e-9);
+            else std::snprintf(le, sizeof(le), "le=\"+Inf\"");
+            sample(bucket, prefix + le, double(cumulative));
+        }
+        sample(std::string(name) + "_sum", labels, snap.sumNs * 1e-9);
+        sample(std::string(name) + "_count", labels, double(snap.count));
+    }
+}
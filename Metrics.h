@@ -0,0 +1,99 @@
+#ifndef LUDO_GAME_METRICS_H
+#define LUDO_GAME_METRICS_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <string_view>
+
+// Lock-free metrics for the Prometheus text format. Every metric is striped over SHARDS
+// cache-line sized cells and each thread updates the cell picked by its own index, so hot
+// counters do not bounce one line between cores. Reads sum the cells and may be slightly
+// behind concurrent updates, which is fine for scraping.
+namespace Metrics {
+    constexpr int SHARDS = 16;
+
+    // This thread's cell, assigned round-robin on first use
+    int shard();
+
+    class Counter {
+    public:
+        void add(uint64_t n = 1) { cells[shard()].value.fetch_add(n, std::memory_order_relaxed); }
+        uint64_t value() const;
+
+    private:
+        struct alignas(64) Cell {
+            std::atomic<uint64_t> value{0};
+        };
+        std::array<Cell, SHARDS> cells;
+    };
+
+    // Durations in nanoseconds over fixed buckets 256 ns * 4^i (256 ns .. ~4.3 s) plus +Inf,
+    // exported in seconds
+    class Histogram {
+    public:
+        static constexpr int BUCKETS = 13;
+
+        void observe(uint64_t ns);
+        void observe(std::chrono::nanoseconds d) { observe(static_cast<uint64_t>(d.count())); }
+
+        static constexpr uint64_t bound(int bucket) { return uint64_t(256) << (2 * bucket); }
+
+        struct Snapshot {
+            std::array<uint64_t, BUCKETS + 1> counts{}; // Per bucket, last is +Inf
+            uint64_t count = 0;
+            uint64_t sumNs = 0;
+        };
+        Snapshot snapshot() const;
+
+    private:
+        struct alignas(64) Cell {
+            std::array<std::atomic<uint64_t>, BUCKETS + 1> counts{};
+            std::atomic<uint64_t> sumNs{0};
+        };
+        std::array<Cell, SHARDS> cells;
+    };
+
+    // Engine-wide metrics, updated by Game and GameManager
+    struct Engine {
+        Counter moves;
+        Counter captures; // Pieces sent back to base
+        Histogram gameLockWait;
+        Histogram managerLockWait;
+    };
+
+    Engine& engine();
+
+    // Acquire `mutex` (exclusively or shared) and record the wait. An uncontended acquire
+    // succeeds on the try and records zero without reading the clock.
+    template <class Lock, class Mutex>
+    Lock lockTimed(Mutex& mutex, Histogram& wait) {
+        Lock lock(mutex, std::try_to_lock);
+        if (lock.owns_lock()) {
+            wait.observe(uint64_t(0));
+            return lock;
+        }
+        const auto t0 = std::chrono::steady_clock::now();
+        lock.lock();
+        wait.observe(std::chrono::steady_clock::now() - t0);
+        return lock;
+    }
+
+    // Prometheus text exposition (format 0.0.4)
+    class Writer {
+    public:
+        void header(std::string_view name, std::string_view help, std::string_view type);
+        void sample(std::string_view name, std::string_view labels, double value);
+        void histogram(std::string_view name, std::string_view labels, const Histogram& histogram);
+
+        const std::string& text() const { return out; }
+
+    private:
+        std::string out;
+    };
+}
+
+#endif //LUDO_GAME_METRICS_H
@@ -0,0 +1,31 @@
+#include "MoveGen.h"
+
+namespace Ludo {
+    template <Position S>
+    void generateMoves(const S& state, int8_t roll, MoveList& out) {
+        out.clear();
+        const int8_t mover = state.currentPlayer;
+
+        // Opponent pieces on the shared track, for the capture flag
+        const Bitboard opponents = occupancy(state).capturable(mover);
+
+        for (int8_t i = 0; i < MAX_PIECES; i++) {
+            const int8_t from = state.progress[mover][i];
+            const int8_t to = static_cast<int8_t>(nextProgress(from, roll));
+            if (to < 0) continue;
+
+            const Bitboard bit = squareBit(squareOf(mover, to));
+            uint8_t flags = 0;
+            if (from < 0) flags |= MOVE_SPAWN;
+            if (bit & opponents) flags |= MOVE_CAPTURE;
+            if (bit & SAFE_SQUARES) flags |= MOVE_SAFE;
+            if (to == HOME_PROGRESS) flags |= MOVE_FINISH;
+            out.push({i, from, to, flags});
+        }
+    }
+
+    template void generateMoves(const GameState&, int8_t, MoveList&);
+    template void generateMoves(const FixedGameState<2>&, int8_t, MoveList&);
+    template void generateMoves(const FixedGameState<3>&, int8_t, MoveList&);
+    template void generateMoves(const FixedGameState<4>&, int8_t, MoveList&);
+}
@@ -0,0 +1,42 @@
+#ifndef LUDO_GAME_MOVEGEN_H
+#define LUDO_GAME_MOVEGEN_H
+
+#include <array>
+#include <cstdint>
+#include "GameState.h"
+
+namespace Ludo {
+    enum MoveFlags : uint8_t {
+        MOVE_SPAWN   = 1 << 0, // Leaves base onto the start square
+        MOVE_CAPTURE = 1 << 1, // Sends at least one opponent piece back to base
+        MOVE_SAFE    = 1 << 2, // Lands on a safe track square
+        MOVE_FINISH  = 1 << 3  // Reaches home
+    };
+
+    struct Move {
+        int8_t piece;
+        int8_t from;   // Progress before the move (-1 = base)
+        int8_t to;     // Progress after the move
+        uint8_t flags; // MoveFlags
+    };
+
+    // Fixed-capacity move buffer: at most one move per piece, lives on the stack.
+    struct MoveList {
+        std::array<Move, MAX_PIECES> moves;
+        uint8_t count = 0;
+
+        void clear() { count = 0; }
+        void push(const Move& m) { moves[count++] = m; }
+        bool empty() const { return count == 0; }
+        uint8_t size() const { return count; }
+        const Move& operator[](int i) const { return moves[i]; }
+        const Move* begin() const { return moves.data(); }
+        const Move* end() const { return moves.data() + count; }
+    };
+
+    // Fill `out` with the current player's legal moves for `roll`. Never allocates.
+    template <Position S>
+    void generateMoves(const S& state, int8_t roll, MoveList& out);
+}
+
+#endif //LUDO_GAME_MOVEGEN_H
@@ -0,0 +1,39 @@
+#ifndef LUDO_GAME_PERFCOUNTERS_H
+#define LUDO_GAME_PERFCOUNTERS_H
+
+#include <array>
+#include <cstdint>
+#include <string>
+
+// Hardware counters for the calling thread and threads it starts while enabled, via Linux
+// perf_event_open. User space only, so it works at the default perf_event_paranoid level.
+// Each event is opened on its own: any the kernel, VM or CPU refuses is simply absent, and
+// with none available (other OS, containers, paranoid=3) the caller falls back to timing.
+class PerfCounters {
+public:
+    enum Event { INSTRUCTIONS, CYCLES, BRANCH_MISSES, L1D_MISSES, LLC_MISSES, EVENT_COUNT };
+
+    struct Reading {
+        std::array<double, EVENT_COUNT> value{}; // Scaled for multiplexing
+        std::array<bool, EVENT_COUNT> valid{};
+    };
+
+    PerfCounters();
+    ~PerfCounters();
+
+    PerfCounters(const PerfCounters&) = delete;
+    PerfCounters& operator=(const PerfCounters&) = delete;
+
+    bool available() const;
+    bool has(Event event) const { return fds[event] >= 0; }
+    static const char* name(Event event);
+
+    // Zero and start every open counter; stop() freezes them and returns the totals
+    void start();
+    Reading stop();
+
+private:
+    std::array<int, EVENT_COUNT> fds;
+};
+
+#endif //LUDO_GAME_PERFCOUNTERS_H
@@ -0,0 +1,76 @@
+#include "Policy.h"
+#include "Computer.h"
+
+using namespace Ludo;
+
+namespace {
+    constexpr int DEFAULT_EXPECTIMAX_US = 100;
+    constexpr int DEFAULT_MCTS_US = 1000;
+    constexpr size_t MCTS_ARENA_MB = 16; // Per seat and worker
+    constexpr int MCTS_PLAYOUT_MOVES = 20; // Then scored by the evaluation: more, less noisy iterations
+
+    Mcts::Config mctsConfig() {
+        Mcts::Config config;
+        config.arenaMB = MCTS_ARENA_MB;
+        config.maxPlayoutMoves = MCTS_PLAYOUT_MOVES;
+        return config;
+    }
+}
+
+Move RandomPolicy::choose(const GameState&, const MoveList& moves, uint64_t random) {
+    return moves[static_cast<int>(random % moves.size())];
+}
+
+Move FirstPolicy::choose(const GameState&, const MoveList& moves, uint64_t) {
+    return moves[0];
+}
+
+Move GreedyPolicy::choose(const GameState&, const MoveList& moves, uint64_t random) {
+    auto score = [](const Move& m) {
+        int s = m.from; // Prefer the most advanced piece
+        if (m.flags & MOVE_CAPTURE) s += 800;
+        if (m.flags & MOVE_FINISH) s += 400;
+        if (m.flags & MOVE_SPAWN) s += 200;
+        if (m.flags & MOVE_SAFE) s += 100;
+        return s;
+    };
+    // Ties are broken from the random value so identical seats do not play identically
+    int start = static_cast<int>(random % moves.size());
+    Move best = moves[start];
+    for (int k = 1; k < moves.size(); k++) {
+        const Move& m = moves[(start + k) % moves.size()];
+        if (score(m) > score(best)) best = m;
+    }
+    return best;
+}
+
+Move ExpectimaxPolicy::choose(const GameState& state, const MoveList& moves, uint64_t) {
+    Move m = Computer::chooseMove(state, state.roll, budget);
+    return m.piece >= 0 ? m : moves[0];
+}
+
+MctsPolicy::MctsPolicy(std::chrono::microseconds budget) : budget(budget), search(mctsConfig()) {}
+
+Move MctsPolicy::choose(const GameState& state, const MoveList& moves, uint64_t) {
+    Move m = search.search(state, budget).move;
+    return m.piece >= 0 ? m : moves[0];
+}
+
+std::unique_ptr<Policy> makePolicy(const std::string& spec) {
+    const std::string kind = spec.substr(0, spec.find(':'));
+    if (kind == "random") return std::make_unique<RandomPolicy>();
+    if (kind == "first") return std::make_unique<FirstPolicy>();
+    if (kind == "greedy") return std::make_unique<GreedyPolicy>();
+    if (kind != "expectimax" && kind != "mcts") return nullptr;
+
+    int us = kind == "mcts" ? DEFAULT_MCTS_US : DEFAULT_EXPECTIMAX_US;
+    if (spec.size() > kind.size()) {
+        try {
+            us = std::stoi(spec.substr(kind.size() + 1));
+        } catch (...) {
+            return nullptr;
+        }
+    }
+    if (kind == "mcts") return std::make_unique<MctsPolicy>(std::chrono::microseconds(us));
+    return std::make_unique<ExpectimaxPolicy>(std::chrono::microseconds(us));
+}
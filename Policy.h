@@ -0,0 +1,70 @@
+#ifndef LUDO_GAME_POLICY_H
+#define LUDO_GAME_POLICY_H
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include "GameState.h"
+#include "Mcts.h"
+#include "MoveGen.h"
+
+// Move selection strategy for one seat in simulated games.
+// Instances are used by one thread at a time; create one per worker.
+class Policy {
+public:
+    virtual ~Policy() = default;
+
+    // Pick one of `moves` (never empty). `random` is a fresh 64-bit random value from the
+    // caller's stream, so policies stay independent of the RNG type.
+    virtual Ludo::Move choose(const Ludo::GameState& state, const Ludo::MoveList& moves, uint64_t random) = 0;
+
+    virtual std::string name() const = 0;
+};
+
+class RandomPolicy : public Policy {
+public:
+    Ludo::Move choose(const Ludo::GameState& state, const Ludo::MoveList& moves, uint64_t random) override;
+    std::string name() const override { return "random"; }
+};
+
+// Always the lowest-numbered movable piece
+class FirstPolicy : public Policy {
+public:
+    Ludo::Move choose(const Ludo::GameState& state, const Ludo::MoveList& moves, uint64_t random) override;
+    std::string name() const override { return "first"; }
+};
+
+// Capture, then finish, then spawn, then safe landing, then the most advanced piece
+class GreedyPolicy : public Policy {
+public:
+    Ludo::Move choose(const Ludo::GameState& state, const Ludo::MoveList& moves, uint64_t random) override;
+    std::string name() const override { return "greedy"; }
+};
+
+class ExpectimaxPolicy : public Policy {
+public:
+    explicit ExpectimaxPolicy(std::chrono::microseconds budget) : budget(budget) {}
+    Ludo::Move choose(const Ludo::GameState& state, const Ludo::MoveList& moves, uint64_t random) override;
+    std::string name() const override { return "expectimax:" + std::to_string(budget.count()); }
+
+private:
+    std::chrono::microseconds budget;
+};
+
+// Single-threaded MCTS with its own tree memory
+class MctsPolicy : public Policy {
+public:
+    explicit MctsPolicy(std::chrono::microseconds budget);
+    Ludo::Move choose(const Ludo::GameState& state, const Ludo::MoveList& moves, uint64_t random) override;
+    std::string name() const override { return "mcts:" + std::to_string(budget.count()); }
+
+private:
+    std::chrono::microseconds budget;
+    Mcts search;
+};
+
+// "random", "first", "greedy", "expectimax[:budget_us]" or "mcts[:budget_us]"; nullptr if unknown
+std::unique_ptr<Policy> makePolicy(const std::string& spec);
+
+#endif //LUDO_GAME_POLICY_H
@@ -0,0 +1,145 @@
+#ifndef LUDO_GAME_RANDOM_H
+#define LUDO_GAME_RANDOM_H
+
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <random>
+
+// Small, seedable generators for dice. Both satisfy std::uniform_random_bit_generator with
+// 64-bit output, so they plug into Game, the simulator and search alike.
+namespace Ludo {
+    constexpr uint64_t splitmix64(uint64_t& x) {
+        uint64_t z = (x += 0x9E3779B97F4A7C15ull);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+
+    // xoshiro256** (Blackman & Vigna): 32 bytes of state, period 2^256 - 1.
+    // jump() advances 2^128 steps, so copies jumped once each are non-overlapping streams.
+    class Xoshiro256ss {
+    public:
+        using result_type = uint64_t;
+
+        explicit Xoshiro256ss(uint64_t seed = 0) { this->seed(seed); }
+
+        void seed(uint64_t seed) {
+            for (auto& word : s) word = splitmix64(seed);
+        }
+
+        static constexpr result_type min() { return 0; }
+        static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+        result_type operator()() {
+            const uint64_t result = rotl(s[1] * 5, 7) * 9;
+            const uint64_t t = s[1] << 17;
+            s[2] ^= s[0];
+            s[3] ^= s[1];
+            s[1] ^= s[2];
+            s[0] ^= s[3];
+            s[2] ^= t;
+            s[3] = rotl(s[3], 45);
+            return result;
+        }
+
+        void jump() { jumpBy({0x180EC6D33CFD0ABAull, 0xD5A61266F0C9392Cull, 0xA9582618E03FC9AAull, 0x39ABDC4529B1661Cull}); }
+
+        // 2^192 steps: split off groups of jump() streams
+        void longJump() { jumpBy({0x76E15D3EFEFDCBBFull, 0xC5004E441C522FB3ull, 0x77710069854EE241ull, 0x39109BB02ACBE635ull}); }
+
+    private:
+        std::array<uint64_t, 4> s;
+
+        static constexpr uint64_t rotl(uint64_t x, int k) { return (x << k) | (x >> (64 - k)); }
+
+        void jumpBy(const std::array<uint64_t, 4>& poly) {
+            std::array<uint64_t, 4> acc{};
+            for (uint64_t word : poly) {
+                for (int b = 0; b < 64; b++) {
+                    if (word & (1ull << b)) {
+                        for (int i = 0; i < 4; i++) acc[i] ^= s[i];
+                    }
+                    (*this)();
+                }
+            }
+            s = acc;
+        }
+    };
+
+    // Philox4x32-10 (Salmon et al.): output is a pure function of (key, stream, position),
+    // so any roll of any game can be recomputed without replaying the ones before it.
+    class Philox4x32 {
+    public:
+        using result_type = uint64_t;
+
+        explicit Philox4x32(uint64_t key = 0, uint64_t stream = 0)
+            : key{static_cast<uint32_t>(key), static_cast<uint32_t>(key >> 32)},
+              stream(stream) {}
+
+        void seed(uint64_t newKey) { *this = Philox4x32(newKey, stream); }
+
+        static constexpr result_type min() { return 0; }
+        static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+        result_type operator()() {
+            if (index == 0) block = generate(counter++);
+            const uint64_t result = uint64_t(block[2 * index]) | uint64_t(block[2 * index + 1]) << 32;
+            index ^= 1;
+            return result;
+        }
+
+        // Jump to the n-th output of this stream
+        void seek(uint64_t n) {
+            counter = n / 2;
+            index = 0;
+            if (n % 2) {
+                block = generate(counter++);
+                index = 1;
+            }
+        }
+
+    private:
+        std::array<uint32_t, 2> key;
+        uint64_t stream;
+        uint64_t counter = 0;   // Block number within the stream
+        std::array<uint32_t, 4> block{};
+        int index = 0;          // Next 64-bit half of `block`; 0 = generate a new block
+
+        std::array<uint32_t, 4> generate(uint64_t position) const {
+            std::array<uint32_t, 4> c = {static_cast<uint32_t>(position), static_cast<uint32_t>(position >> 32),
+                                         static_cast<uint32_t>(stream), static_cast<uint32_t>(stream >> 32)};
+            std::array<uint32_t, 2> k = key;
+            for (int round = 0; round < 10; round++) {
+                const uint64_t p0 = uint64_t(0xD2511F53u) * c[0];
+                const uint64_t p1 = uint64_t(0xCD9E8D57u) * c[2];
+                c = {static_cast<uint32_t>(p1 >> 32) ^ c[1] ^ k[0], static_cast<uint32_t>(p1),
+                     static_cast<uint32_t>(p0 >> 32) ^ c[3] ^ k[1], static_cast<uint32_t>(p0)};
+                k[0] += 0x9E3779B9u;
+                k[1] += 0xBB67AE85u;
+            }
+            return c;
+        }
+    };
+
+    // Unbiased integer in [0, range) by Lemire's multiply-shift; the division only runs in
+    // the rare case the low product lands in the biased zone.
+    template <class Rng>
+    uint32_t uniformBelow(Rng& rng, uint32_t range) {
+        static_assert(std::uniform_random_bit_generator<Rng> && Rng::max() == UINT64_MAX,
+                      "Expects a 64-bit generator");
+        uint64_t m = (rng() >> 32) * range;
+        if (static_cast<uint32_t>(m) < range) {
+            const uint32_t threshold = static_cast<uint32_t>(-range) % range;
+            while (static_cast<uint32_t>(m) < threshold) m = (rng() >> 32) * range;
+        }
+        return static_cast<uint32_t>(m >> 32);
+    }
+
+    template <class Rng>
+    int8_t rollDie(Rng& rng) {
+        return static_cast<int8_t>(uniformBelow(rng, 6) + 1);
+    }
+}
+
+#endif //LUDO_GAME_RANDOM_H
@@ -0,0 +1,57 @@
+#ifndef LUDO_GAME_THREADPOOL_H
+#define LUDO_GAME_THREADPOOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Work-stealing pool: every worker owns a task deque, runs its own work newest-first and
+// steals the oldest task from a sibling when it runs dry.
+class ThreadPool {
+public:
+    explicit ThreadPool(size_t threads = std::thread::hardware_concurrency());
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    // From a worker the task goes on that worker's own deque, otherwise round-robin
+    void submit(std::function<void()> task);
+
+    // Block until every task submitted so far has finished. Not callable from a task.
+    void wait();
+
+    size_t size() const { return workers.size(); }
+
+    // Index of the calling worker in [0, size()), or -1 outside the pool
+    static int currentWorker();
+
+private:
+    struct Queue {
+        std::mutex mutex;
+        std::deque<std::function<void()>> tasks;
+    };
+
+    std::vector<std::unique_ptr<Queue>> queues;
+    std::vector<std::thread> workers;
+    std::atomic<size_t> nextQueue{0};
+    std::atomic<size_t> queued{0};  // Tasks sitting in some deque
+    std::atomic<size_t> pending{0}; // Queued + running
+
+    std::mutex sleepMutex;
+    std::condition_variable taskReady;
+    std::condition_variable allDone;
+    bool stopping = false;
+
+    bool popLocal(size_t self, std::function<void()>& task);
+    bool steal(size_t self, std::function<void()>& task);
+    void workerLoop(size_t self);
+};
+
+#endif //LUDO_GAME_THREADPOOL_H
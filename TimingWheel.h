@@ -0,0 +1,87 @@
+#ifndef LUDO_GAME_TIMINGWHEEL_H
+#define LUDO_GAME_TIMINGWHEEL_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+// Hierarchical timing wheel over integer ticks (as in the classic Linux timer wheel).
+// LEVELS wheels of SLOTS slots each: level L holds timers due 64^L .. 64^(L+1) ticks out,
+// and a slot is cascaded one level down when the clock reaches it. Scheduling is O(1) and
+// each timer is touched at most LEVELS times, however many timers are pending.
+// Timers cannot be cancelled: the owner ignores or reschedules stale ones when they fire.
+// Not thread-safe.
+class TimingWheel {
+public:
+    static constexpr int SLOT_BITS = 6;
+    static constexpr int SLOTS = 1 << SLOT_BITS;
+    static constexpr int LEVELS = 4; // 2^24 ticks of range; later deadlines are re-armed
+
+    explicit TimingWheel(uint64_t now = 0) : current(now) {}
+
+    // A deadline already passed fires on the next advance()
+    void schedule(uint64_t id, uint64_t deadline) {
+        place({id, deadline});
+        pending++;
+    }
+
+    size_t size() const { return pending; }
+
+    // Run the clock up to and including `now`, calling expired(id) for every due timer
+    template <class F>
+    void advance(uint64_t now, F&& expired) {
+        for (; current <= now; current++) {
+            const int index = static_cast<int>(current & (SLOTS - 1));
+            // Crossing a level-0 revolution: pull the next slot of each higher level down
+            for (int level = 1; level < LEVELS && slotIndex(current, level - 1) == 0; level++) {
+                cascade(level, slotIndex(current, level));
+            }
+            std::vector<Timer> due = std::exchange(wheels[0][index], {});
+            for (const Timer& timer : due) {
+                if (timer.deadline > current) {
+                    place(timer); // Beyond the wheel's range when scheduled
+                } else {
+                    pending--;
+                    expired(timer.id);
+                }
+            }
+        }
+    }
+
+private:
+    struct Timer {
+        uint64_t id;
+        uint64_t deadline;
+    };
+
+    std::array<std::array<std::vector<Timer>, SLOTS>, LEVELS> wheels;
+    uint64_t current; // Next tick to process
+    size_t pending = 0;
+
+    static int slotIndex(uint64_t tick, int level) {
+        return static_cast<int>((tick >> (level * SLOT_BITS)) & (SLOTS - 1));
+    }
+
+    void place(const Timer& timer) {
+        const uint64_t at = timer.deadline < current ? current : timer.deadline;
+        const uint64_t delta = at - current;
+        for (int level = 0; level < LEVELS; level++) {
+            if (delta < (uint64_t(1) << ((level + 1) * SLOT_BITS))) {
+                wheels[level][slotIndex(at, level)].push_back(timer);
+                return;
+            }
+        }
+        // Out of range: park in the farthest top-level slot and re-place when it comes down
+        const uint64_t far = current + (uint64_t(1) << (LEVELS * SLOT_BITS)) - 1;
+        wheels[LEVELS - 1][slotIndex(far, LEVELS - 1)].push_back(timer);
+    }
+
+    void cascade(int level, int index) {
+        std::vector<Timer> timers = std::exchange(wheels[level][index], {});
+        for (const Timer& timer : timers) place(timer);
+    }
+};
+
+#endif //LUDO_GAME_TIMINGWHEEL_H
@@ -0,0 +1,116 @@
+#include "TranspositionTable.h"
+#include <algorithm>
+#include <bit>
+#include <functional>
+#include <limits>
+#include <thread>
+
+namespace {
+    // data word layout:
+    //   bits  0-31  value (float bits)
+    //   bits 32-39  depth
+    //   bits 40-41  bound (never NONE in a live slot, so live data is never 0)
+    //   bits 42-44  move + 1
+    //   bits 48-55  generation
+    uint64_t pack(float value, int8_t depth, TranspositionTable::Bound bound, int8_t move, uint8_t gen) {
+        return uint64_t(std::bit_cast<uint32_t>(value)) |
+               uint64_t(uint8_t(depth)) << 32 |
+               uint64_t(bound) << 40 |
+               uint64_t(move + 1) << 42 |
+               uint64_t(gen) << 48;
+    }
+
+    int8_t depthOf(uint64_t data) { return int8_t(data >> 32); }
+    uint8_t generationOf(uint64_t data) { return uint8_t(data >> 48); }
+
+    TranspositionTable::Entry unpack(uint64_t data) {
+        return {
+            std::bit_cast<float>(uint32_t(data)),
+            depthOf(data),
+            TranspositionTable::Bound((data >> 40) & 0x3),
+            int8_t(((data >> 42) & 0x7) - 1)
+        };
+    }
+}
+
+TranspositionTable::TranspositionTable(size_t megabytes) {
+    resize(megabytes);
+}
+
+void TranspositionTable::resize(size_t megabytes) {
+    size_t count = std::bit_floor(std::max<size_t>(1, (megabytes << 20) / sizeof(Bucket)));
+    buckets.reset(new Bucket[count]());
+    mask = count - 1;
+}
+
+void TranspositionTable::clear() {
+    for (size_t i = 0; i <= mask; i++) {
+        for (Slot& slot : buckets[i].slots) {
+            slot.check.store(0, std::memory_order_relaxed);
+            slot.data.store(0, std::memory_order_relaxed);
+        }
+    }
+}
+
+TranspositionTable::Counters& TranspositionTable::localCounters() const {
+    static thread_local const size_t stripe = std::hash<std::thread::id>{}(std::this_thread::get_id()) % COUNTER_STRIPES;
+    return counters[stripe];
+}
+
+bool TranspositionTable::probe(uint64_t key, Entry& out) const {
+    const Bucket& bucket = buckets[key & mask];
+    for (const Slot& slot : bucket.slots) {
+        uint64_t data = slot.data.load(std::memory_order_relaxed);
+        if (data != 0 && (slot.check.load(std::memory_order_relaxed) ^ data) == key) {
+            out = unpack(data);
+            localCounters().hits.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+    localCounters().misses.fetch_add(1, std::memory_order_relaxed);
+    return false;
+}
+
+void TranspositionTable::store(uint64_t key, float value, int8_t depth, Bound bound, int8_t move) {
+    Bucket& bucket = buckets[key & mask];
+    const uint8_t gen = generation.load(std::memory_order_relaxed);
+
+    // Same position first, then an empty slot, then the shallowest / oldest entry
+    Slot* victim = nullptr;
+    int victimScore = std::numeric_limits<int>::max();
+    bool evictsOther = false;
+    for (Slot& slot : bucket.slots) {
+        uint64_t data = slot.data.load(std::memory_order_relaxed);
+        if (data != 0 && (slot.check.load(std::memory_order_relaxed) ^ data) == key) {
+            victim = &slot;
+            evictsOther = false;
+            break;
+        }
+        int age = uint8_t(gen - generationOf(data));
+        int score = data == 0 ? std::numeric_limits<int>::min() : depthOf(data) - 8 * age;
+        if (score < victimScore) {
+            victim = &slot;
+            victimScore = score;
+            evictsOther = data != 0;
+        }
+    }
+
+    uint64_t data = pack(value, depth, bound, move, gen);
+    victim->data.store(data, std::memory_order_relaxed);
+    victim->check.store(key ^ data, std::memory_order_relaxed);
+
+    Counters& c = localCounters();
+    c.stores.fetch_add(1, std::memory_order_relaxed);
+    if (evictsOther) c.collisions.fetch_add(1, std::memory_order_relaxed);
+}
+
+TranspositionTable::Stats TranspositionTable::stats() const {
+    Stats s{};
+    for (const Counters& c : counters) {
+        s.hits += c.hits.load(std::memory_order_relaxed);
+        s.misses += c.misses.load(std::memory_order_relaxed);
+        s.collisions += c.collisions.load(std::memory_order_relaxed);
+        s.stores += c.stores.load(std::memory_order_relaxed);
+    }
+    return s;
+}
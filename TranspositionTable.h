@@ -0,0 +1,83 @@
+#ifndef LUDO_GAME_TRANSPOSITIONTABLE_H
+#define LUDO_GAME_TRANSPOSITIONTABLE_H
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+// Fixed-size hash table of search results keyed by GameState::hash.
+// Shared by any number of threads without locks: each slot stores (key ^ data, data)
+// as two independent words, so a torn read from a racing writer fails verification
+// and is treated as a miss.
+class TranspositionTable {
+public:
+    enum class Bound : uint8_t {
+        NONE,  // Empty slot
+        EXACT,
+        LOWER, // value is a lower bound (fail high)
+        UPPER  // value is an upper bound (fail low)
+    };
+
+    struct Entry {
+        float value;
+        int8_t depth;
+        Bound bound;
+        int8_t move; // Best piece, -1 if none
+    };
+
+    struct Stats {
+        uint64_t hits;
+        uint64_t misses;
+        uint64_t collisions; // Stores that evicted a live entry of another position
+        uint64_t stores;
+    };
+
+    explicit TranspositionTable(size_t megabytes);
+
+    // Reallocate to the largest power-of-two bucket count that fits in `megabytes`. Not thread-safe.
+    void resize(size_t megabytes);
+    void clear();
+
+    // Start of a new root search: older entries become preferred replacement victims
+    void newSearch() { generation.fetch_add(1, std::memory_order_relaxed); }
+
+    bool probe(uint64_t key, Entry& out) const;
+    void store(uint64_t key, float value, int8_t depth, Bound bound, int8_t move);
+
+    Stats stats() const;
+    size_t sizeBytes() const { return (mask + 1) * sizeof(Bucket); }
+
+private:
+    static constexpr int SLOTS_PER_BUCKET = 4;
+    static constexpr int COUNTER_STRIPES = 16;
+
+    struct Slot {
+        std::atomic<uint64_t> check; // key ^ data
+        std::atomic<uint64_t> data;
+    };
+
+    // One bucket per cache line: a probe touches exactly one line
+    struct alignas(64) Bucket {
+        Slot slots[SLOTS_PER_BUCKET];
+    };
+    static_assert(sizeof(Bucket) == 64, "Bucket must fill one cache line");
+
+    // Counters are striped by thread so probes from many threads do not share a line
+    struct alignas(64) Counters {
+        std::atomic<uint64_t> hits{0};
+        std::atomic<uint64_t> misses{0};
+        std::atomic<uint64_t> collisions{0};
+        std::atomic<uint64_t> stores{0};
+    };
+
+    std::unique_ptr<Bucket[]> buckets;
+    size_t mask = 0;
+    std::atomic<uint8_t> generation{0};
+    mutable std::array<Counters, COUNTER_STRIPES> counters;
+
+    Counters& localCounters() const;
+};
+
+#endif //LUDO_GAME_TRANSPOSITIONTABLE_H
@@ -0,0 +1,43 @@
+#ifndef LUDO_GAME_ZOBRIST_H
+#define LUDO_GAME_ZOBRIST_H
+
+#include <array>
+#include <cstdint>
+#include "Constants.h"
+#include "Random.h"
+
+namespace Ludo::Zobrist {
+    struct Keys {
+        // A piece in base contributes nothing, so a fresh board hashes to the side and seat-count keys alone
+        std::array<std::array<std::array<uint64_t, PROGRESS_SLOTS>, MAX_PIECES>, MAX_PLAYERS> piece{};
+        std::array<uint64_t, MAX_PLAYERS> side{};
+        std::array<uint64_t, 7> roll{}; // Pending roll 1-6; index 0 unused
+        // Seat count 2-4. Empty seats hash to zero, so without this a 2-player position and a
+        // 4-player one with seats 2 and 3 still in base would share a key.
+        std::array<uint64_t, MAX_PLAYERS + 1> players{};
+    };
+
+    constexpr Keys makeKeys() {
+        Keys k;
+        uint64_t seed = 0x4C55444F5A4F4252ull; // "LUDOZOBR"
+        for (auto& player : k.piece)
+            for (auto& piece : player)
+                for (int i = 1; i < PROGRESS_SLOTS; i++) piece[i] = splitmix64(seed);
+        for (auto& s : k.side) s = splitmix64(seed);
+        for (int r = 1; r <= 6; r++) k.roll[r] = splitmix64(seed);
+        for (int n = 2; n <= MAX_PLAYERS; n++) k.players[n] = splitmix64(seed);
+        return k;
+    }
+
+    // Generated at compile time; no static initialization order concerns
+    inline constexpr Keys KEYS = makeKeys();
+
+    constexpr uint64_t piece(int playerIdx, int pieceIdx, int progress) {
+        return KEYS.piece[playerIdx][pieceIdx][progress + 1];
+    }
+    constexpr uint64_t side(int playerIdx) { return KEYS.side[playerIdx]; }
+    constexpr uint64_t roll(int value) { return KEYS.roll[value]; }
+    constexpr uint64_t players(int count) { return KEYS.players[count]; }
+}
+
+#endif //LUDO_GAME_ZOBRIST_H
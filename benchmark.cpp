@@ -1,31 +1,513 @@
-#include <iostream>
+#include <algorithm>
+#include <barrier>
 #include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include "AllocTracker.h"
 #include "Game.h"
+#include "GameManager.h"
+#include "GameState.h"
+#include "MoveGen.h"
+#include "PerfCounters.h"
 #include "Player.h"
+#include "Random.h"
+#include "libs/json.hpp"
+
+#if defined(__x86_64__) || defined(_M_X64)
+#include <x86intrin.h>
+#define LUDO_HAVE_TSC 1
+#endif
+
+using namespace Ludo;
+using json = nlohmann::json;
+
+// Benchmark suite. Every scenario is calibrated so one sample takes about --sample-ms,
+// run for --warmup unrecorded samples, then --samples recorded ones. Reported per op:
+// median, min and mean nanoseconds over the samples, p99 over short separately timed
+// batches (single-threaded scenarios), TSC cycles where the CPU has one, and
+// hardware counters per op (IPC, branch and cache misses) when perf_event_open allows,
+// and heap allocations per op in builds configured with -DLUDO_ALLOC_TRACKING=ON.
+// Results go to stderr as a table and to --out as JSON for diffing between releases.
+namespace {
+    struct Options {
+        int samples = 30;
+        int warmup = 3;
+        double sampleMs = 20;
+        int threads = static_cast<int>(std::max(2u, std::thread::hardware_concurrency()));
+        std::string filter;
+        std::string out = "benchmark.json";
+        uint64_t seed = 1;
+        bool counters = true;
+    };
+
+    struct Scenario {
+        std::string name;
+        std::string unit;   // What one op is
+        int threads = 1;
+        std::function<void(uint64_t ops)> run;
+    };
+
+    struct Summary {
+        double min, median, mean;
+    };
+
+    // p99 batches: LATENCY_BATCHES of them, each about LATENCY_BATCH_NS long, or a single op
+    // where one op takes longer. Short enough to catch a slow op, long enough that reading
+    // the clock twice per batch adds about 1%.
+    constexpr int LATENCY_BATCHES = 2000;
+    constexpr double LATENCY_BATCH_NS = 2000;
+
+    // Keep a value alive without letting the compiler see through it
+    template <class T>
+    void keep(const T& value) {
+#if defined(__GNUC__)
+        asm volatile("" : : "r,m"(value) : "memory");
+#else
+        static volatile T sink;
+        sink = value;
+#endif
+    }
+
+    uint64_t cycles() {
+#ifdef LUDO_HAVE_TSC
+        return __rdtsc();
+#else
+        return 0;
+#endif
+    }
+
+    Summary summarize(std::vector<double> values) {
+        std::sort(values.begin(), values.end());
+        const size_t n = values.size();
+        double sum = 0;
+        for (double v : values) sum += v;
+        const double median = n % 2 ? values[n / 2] : (values[n / 2 - 1] + values[n / 2]) / 2;
+        return {values.front(), median, sum / n};
+    }
+
+    // Nearest-rank percentile, q in (0, 1]
+    double percentile(std::vector<double> values, double q) {
+        const size_t rank = static_cast<size_t>(std::ceil(q * values.size())) - 1;
+        std::nth_element(values.begin(), values.begin() + rank, values.end());
+        return values[rank];
+    }
+
+    json toJson(const Summary& s) {
+        return {{"min", s.min}, {"median", s.median}, {"mean", s.mean}};
+    }
+
+    // Counter totals over all recorded samples, per op; null where an event is unavailable
+    json counterJson(const PerfCounters::Reading& reading, double ops) {
+        json j;
+        for (int e = 0; e < PerfCounters::EVENT_COUNT; e++) {
+            const auto event = static_cast<PerfCounters::Event>(e);
+            j[PerfCounters::name(event)] = reading.valid[e] ? json(reading.value[e] / ops) : json(nullptr);
+        }
+        const bool ipc = reading.valid[PerfCounters::INSTRUCTIONS] && reading.valid[PerfCounters::CYCLES] &&
+                         reading.value[PerfCounters::CYCLES] > 0;
+        j["ipc"] = ipc ? json(reading.value[PerfCounters::INSTRUCTIONS] / reading.value[PerfCounters::CYCLES])
+                       : json(nullptr);
+        return j;
+    }
+
+    std::string cell(const json& value, const char* format) {
+        if (value.is_null()) return "-";
+        char buf[32];
+        std::snprintf(buf, sizeof(buf), format, value.get<double>());
+        return buf;
+    }
+
+    json measure(const Options& opt, const Scenario& sc, PerfCounters* perf) {
+        using clock = std::chrono::steady_clock;
+        auto timeOps = [&](uint64_t ops) {
+            const auto t0 = clock::now();
+            sc.run(ops);
+            return std::chrono::duration<double, std::nano>(clock::now() - t0).count();
+        };
+
+        // Double until a run is long enough to scale from, then size samples to --sample-ms
+        uint64_t ops = 1;
+        double ns = timeOps(ops);
+        while (ns < opt.sampleMs * 1e6 / 8 && ops < (1ull << 40)) ns = timeOps(ops *= 2);
+        const uint64_t opsPerSample = std::max<uint64_t>(1, static_cast<uint64_t>(ops * opt.sampleMs * 1e6 / ns));
+
+        for (int i = 0; i < opt.warmup; i++) sc.run(opsPerSample);
+
+        std::vector<double> nsPerOp, cyclesPerOp;
+        nsPerOp.reserve(opt.samples); // No allocations of our own inside the counted window
+        cyclesPerOp.reserve(opt.samples);
+        const AllocTracker::Counts heap0 = AllocTracker::process();
+        if (perf) perf->start();
+        for (int i = 0; i < opt.samples; i++) {
+            const uint64_t c0 = cycles();
+            const auto t0 = clock::now();
+            sc.run(opsPerSample);
+            const auto t1 = clock::now();
+            const uint64_t c1 = cycles();
+            nsPerOp.push_back(std::chrono::duration<double, std::nano>(t1 - t0).count() / opsPerSample);
+            cyclesPerOp.push_back(double(c1 - c0) / opsPerSample);
+        }
+        const json counters = perf ? counterJson(perf->stop(), double(opsPerSample) * opt.samples) : json(nullptr);
+        const AllocTracker::Counts heap = AllocTracker::process() - heap0;
+        const double totalOps = double(opsPerSample) * opt.samples;
+        const json allocations = AllocTracker::enabled
+            ? json{{"allocations_per_op", heap.allocations / totalOps},
+                   {"bytes_per_op", heap.bytes / totalOps},
+                   {"frees_per_op", heap.frees / totalOps}}
+            : json(nullptr);
+
+        const Summary t = summarize(nsPerOp);
+
+        // Tail latency. Every sample above averages millions of ops, so its spread says
+        // nothing about slow ops; time short batches instead. Multi-threaded scenarios
+        // report aggregate throughput only.
+        uint64_t batchOps = 0;
+        double p99 = 0;
+        if (sc.threads == 1) {
+            batchOps = std::clamp<uint64_t>(static_cast<uint64_t>(LATENCY_BATCH_NS / t.median), 1, opsPerSample);
+            std::vector<double> batchNs;
+            batchNs.reserve(LATENCY_BATCHES);
+            for (int i = 0; i < LATENCY_BATCHES; i++) {
+                batchNs.push_back(timeOps(batchOps) / batchOps);
+            }
+            p99 = percentile(std::move(batchNs), 0.99);
+        }
+        json nsJson = toJson(t);
+        nsJson["p99"] = batchOps ? json(p99) : json(nullptr);
+
+        json result = {
+            {"name", sc.name},
+            {"unit", sc.unit},
+            {"threads", sc.threads},
+            {"samples", opt.samples},
+            {"ops_per_sample", opsPerSample},
+            {"ns_per_op", nsJson},
+            {"p99_batch_ops", batchOps ? json(batchOps) : json(nullptr)},
+            {"ops_per_sec", 1e9 / t.median},
+            {"counters", counters},
+            {"heap", allocations}
+        };
+#ifdef LUDO_HAVE_TSC
+        result["tsc_cycles_per_op"] = toJson(summarize(cyclesPerOp));
+#else
+        result["tsc_cycles_per_op"] = nullptr;
+#endif
+        const json none;
+        std::fprintf(stderr, "%-22s %-10s %8.1f %8s %8.1f %10.1f %14.0f %6s %8s %8s %9s\n", sc.name.c_str(),
+                     sc.unit.c_str(), t.median, cell(nsJson["p99"], "%.1f").c_str(), t.min,
+                     summarize(cyclesPerOp).median, 1e9 / t.median,
+                     cell(perf ? counters["ipc"] : none, "%.2f").c_str(),
+                     cell(perf ? counters["branch_misses"] : none, "%.3f").c_str(),
+                     cell(perf ? counters["l1d_misses"] : none, "%.3f").c_str(),
+                     cell(AllocTracker::enabled ? allocations["allocations_per_op"] : none, "%.2f").c_str());
+        return result;
+    }
+
+    // Play one move of a random game, starting a new game when the last one ends
+    template <class Rng>
+    void randomMove(GameState& state, Rng& rng) {
+        for (;;) {
+            if (isTerminal(state)) state = makeGameState(state.numPlayers);
+            if (state.phase == Phase::WAITING_FOR_ROLL) {
+                applyRoll(state, rollDie(rng));
+                continue;
+            }
+            MoveList moves;
+            generateMoves(state, state.roll, moves);
+            applyMove(state, moves[uniformBelow(rng, moves.size())].piece);
+            return;
+        }
+    }
+
+    // Positions waiting for a move with at least one capture available
+    std::vector<GameState> captureMidgames(uint64_t seed, size_t count) {
+        std::vector<GameState> positions;
+        Xoshiro256ss rng(seed);
+        GameState state = makeGameState(MAX_PLAYERS);
+        while (positions.size() < count) {
+            randomMove(state, rng);
+            if (state.phase != Phase::WAITING_FOR_ROLL) continue;
+            GameState next = state;
+            applyRoll(next, rollDie(rng));
+            if (next.phase != Phase::WAITING_FOR_MOVE) continue;
+            MoveList moves;
+            generateMoves(next, next.roll, moves);
+            for (const Move& m : moves) {
+                if (m.flags & MOVE_CAPTURE) {
+                    positions.push_back(next);
+                    break;
+                }
+            }
+        }
+        return positions;
+    }
 
-void runBenchmark() {
-    Game game;
-    game.addPlayer(Player(0, "P0", "Green", false));
-    game.addPlayer(Player(1, "P1", "Red", false));
-    
-    const int iterations = 1000000;
-    auto start = std::chrono::high_resolution_clock::now();
-    
-    for (int i = 0; i < iterations; ++i) {
-        // Simulate a simple move cycle
-        game.rollDiceForPlayer(0);
-        game.makeMoveForPlayer(0, 0);
-    }
-    
-    auto end = std::chrono::high_resolution_clock::now();
-    std::chrono::duration<double> diff = end - start;
-    
-    std::cout << "Engine Performance Benchmark:" << std::endl;
-    std::cout << "Total time for " << iterations << " move cycles: " << diff.count() << " seconds" << std::endl;
-    std::cout << "Average time per move cycle: " << (diff.count() / iterations) * 1e6 << " microseconds" << std::endl;
+    // Snapshot positions from random play, each with a pending roll
+    std::vector<GameState> midgames(uint64_t seed, size_t count) {
+        std::vector<GameState> positions;
+        Xoshiro256ss rng(seed);
+        GameState state = makeGameState(MAX_PLAYERS);
+        while (positions.size() < count) {
+            randomMove(state, rng);
+            if (state.phase == Phase::WAITING_FOR_ROLL) {
+                GameState next = state;
+                next.roll = rollDie(rng);
+                positions.push_back(next);
+            }
+        }
+        return positions;
+    }
+
+    // Worker threads for one multi-threaded scenario, started once. run() releases them all
+    // through a start barrier and returns once each has reached the end barrier, so a sample
+    // times the work and two barrier crossings, never a thread spawn or join. A crew of one
+    // runs the body on the caller: the single-thread baseline has no handoff at all.
+    class Crew {
+    public:
+        using Body = std::function<void(int thread, uint64_t ops)>;
+
+        Crew(int threads, Body work) : body(std::move(work)), start(threads + 1), finish(threads + 1) {
+            for (int t = 0; threads > 1 && t < threads; t++) {
+                workers.emplace_back([this, t] {
+                    for (;;) {
+                        start.arrive_and_wait();
+                        if (stopping) return;
+                        body(t, ops);
+                        finish.arrive_and_wait();
+                    }
+                });
+            }
+        }
+
+        ~Crew() {
+            if (workers.empty()) return;
+            stopping = true;
+            start.arrive_and_wait();
+            for (auto& w : workers) w.join();
+        }
+
+        void run(uint64_t total) {
+            if (workers.empty()) return body(0, total);
+            ops = total; // Published to the workers by the barrier
+            start.arrive_and_wait();
+            finish.arrive_and_wait();
+        }
+
+    private:
+        Body body;
+        std::barrier<> start, finish;
+        uint64_t ops = 0;
+        bool stopping = false;
+        std::vector<std::thread> workers; // Last: started once everything above exists
+    };
+
+    std::shared_ptr<Game> seatedGame(int players, uint64_t seed) {
+        auto game = Game::create(players, seed);
+        for (int seat = 0; seat < players; seat++) {
+            std::string name;
+            name.reserve(4);
+            name.append("P").append(std::to_string(seat)); // Not "P" + ...: GCC 12 -Wrestrict false positive
+            game->addPlayer(Player(seat, name, "#000000", false));
+        }
+        return game;
+    }
+
+    // One move through the public Game API (locks, validation, history), like a server request
+    void apiMove(Game& game, Xoshiro256ss& rng) {
+        for (;;) {
+            if (game.getGameStateEnum() == Phase::GAME_OVER) game.resetGame();
+            const int8_t player = game.getCurrentPlayer();
+            if (game.getGameStateEnum() == Phase::WAITING_FOR_ROLL) {
+                game.rollDiceForPlayer(player);
+                continue;
+            }
+            const MoveList moves = game.getLegalMoves();
+            game.makeMoveForPlayer(player, moves[uniformBelow(rng, moves.size())].piece);
+            return;
+        }
+    }
+
+    std::vector<Scenario> makeScenarios(const Options& opt) {
+        std::vector<Scenario> scenarios;
+
+        scenarios.push_back({"random_games", "move", 1, [state = makeGameState(MAX_PLAYERS),
+                                                          rng = Xoshiro256ss(opt.seed)](uint64_t ops) mutable {
+            for (uint64_t i = 0; i < ops; i++) randomMove(state, rng);
+            keep(state.hash);
+        }});
+
+        auto captures = std::make_shared<std::vector<GameState>>(captureMidgames(opt.seed, 4096));
+        scenarios.push_back({"capture_midgame", "move", 1, [captures, next = size_t(0)](uint64_t ops) mutable {
+            for (uint64_t i = 0; i < ops; i++) {
+                GameState& state = (*captures)[next++ & (captures->size() - 1)];
+                MoveList moves;
+                generateMoves(state, state.roll, moves);
+                int8_t piece = moves[0].piece;
+                for (const Move& m : moves) {
+                    if (m.flags & MOVE_CAPTURE) piece = m.piece;
+                }
+                const UndoRecord undo = applyMove(state, piece);
+                keep(state.hash);
+                undoMove(state, undo);
+            }
+        }});
+
+        auto positions = std::make_shared<std::vector<GameState>>(midgames(opt.seed, 4096));
+        scenarios.push_back({"move_generation", "call", 1, [positions, next = size_t(0)](uint64_t ops) mutable {
+            for (uint64_t i = 0; i < ops; i++) {
+                const GameState& state = (*positions)[next++ & (positions->size() - 1)];
+                MoveList moves;
+                generateMoves(state, state.roll, moves);
+                keep(moves.count);
+            }
+        }});
+
+        scenarios.push_back({"game_api_moves", "move", 1, [game = seatedGame(MAX_PLAYERS, opt.seed),
+                                                            rng = Xoshiro256ss(opt.seed)](uint64_t ops) mutable {
+            for (uint64_t i = 0; i < ops; i++) apiMove(*game, rng);
+        }});
+
+        auto served = seatedGame(MAX_PLAYERS, opt.seed);
+        Xoshiro256ss warm(opt.seed);
+        for (int i = 0; i < 120; i++) apiMove(*served, warm); // Pieces spread over the board
+        scenarios.push_back({"get_game_state", "call", 1, [served](uint64_t ops) {
+            for (uint64_t i = 0; i < ops; i++) {
+                const std::string body = served->getGameState().dump();
+                keep(body.size());
+            }
+        }});
+
+        // Mostly lookups with a create/remove pair every 16th op, from several threads at once
+        auto manager = std::make_shared<GameManager>(opt.seed);
+        auto ids = std::make_shared<std::vector<GameId>>();
+        for (int i = 0; i < 1024; i++) ids->push_back(manager->createGame());
+        const int threads = opt.threads;
+        auto mixed = std::make_shared<Crew>(threads, [manager, ids, threads](int t, uint64_t ops) {
+            Xoshiro256ss rng(t + 1);
+            GameId own = GameManager::NO_GAME;
+            for (uint64_t i = t; i < ops; i += threads) {
+                if (i % 16 == 0) {
+                    if (own != GameManager::NO_GAME) manager->removeGame(own);
+                    own = manager->createGame();
+                } else {
+                    keep(manager->getGame((*ids)[uniformBelow(rng, ids->size())]).get());
+                }
+            }
+            if (own != GameManager::NO_GAME) manager->removeGame(own);
+        });
+        scenarios.push_back({"manager_create_get", "call", threads, [mixed](uint64_t ops) { mixed->run(ops); }});
+
+        // Create and remove one game per op: after the first op every create reuses the
+        // game the previous remove returned to the pool
+        scenarios.push_back({"manager_create_remove", "call", 1, [pooled = std::make_shared<GameManager>(opt.seed)](uint64_t ops) {
+            for (uint64_t i = 0; i < ops; i++) pooled->removeGame(pooled->createGame());
+        }});
+
+        // Lookup-only contention: aggregate getGame throughput at 1, 2, 4 ... --threads threads.
+        // Linear growth in ops/s means readers are not serialised on a lock.
+        auto registry = std::make_shared<GameManager>(opt.seed);
+        auto registered = std::make_shared<std::vector<GameId>>();
+        for (int i = 0; i < 4096; i++) registered->push_back(registry->createGame());
+        for (int t = 1;; t = std::min(t * 2, opt.threads)) {
+            auto readers = std::make_shared<Crew>(t, [registry, registered, t](int w, uint64_t ops) {
+                Xoshiro256ss rng(w + 1);
+                for (uint64_t i = w; i < ops; i += t) {
+                    keep(registry->getGame((*registered)[uniformBelow(rng, registered->size())]).get());
+                }
+            });
+            scenarios.push_back({"manager_get_" + std::to_string(t) + "t", "call", t,
+                                 [readers](uint64_t ops) { readers->run(ops); }});
+            if (t == opt.threads) break;
+        }
+
+        return scenarios;
+    }
+
+    void usage() {
+        std::cerr << "Usage: Ludo_Benchmark [--samples N] [--warmup N] [--sample-ms MS] [--threads T]\n"
+                     "                      [--filter SUBSTRING] [--out FILE.json] [--seed S]\n"
+                     "                      [--counters on|off]\n";
+    }
+
+    bool parseArgs(int argc, char** argv, Options& opt) {
+        for (int i = 1; i < argc; i++) {
+            std::string arg = argv[i];
+            if (i + 1 >= argc) return false;
+            std::string value = argv[++i];
+            try {
+                if (arg == "--samples") opt.samples = std::stoi(value);
+                else if (arg == "--warmup") opt.warmup = std::stoi(value);
+                else if (arg == "--sample-ms") opt.sampleMs = std::stod(value);
+                else if (arg == "--threads") opt.threads = std::stoi(value);
+                else if (arg == "--filter") opt.filter = value;
+                else if (arg == "--out") opt.out = value;
+                else if (arg == "--seed") opt.seed = std::stoull(value);
+                else if (arg == "--counters") opt.counters = value != "off";
+                else return false;
+            } catch (...) {
+                return false;
+            }
+        }
+        return opt.samples > 0 && opt.warmup >= 0 && opt.sampleMs > 0 && opt.threads > 0;
+    }
 }
 
-int main() {
-    runBenchmark();
-    return 0;
+int main(int argc, char** argv) {
+    Options opt;
+    if (!parseArgs(argc, argv, opt)) {
+        usage();
+        return 1;
+    }
+
+    // Timing only when counters are off or the kernel refuses them
+    std::unique_ptr<PerfCounters> perf;
+    if (opt.counters) {
+        perf = std::make_unique<PerfCounters>();
+        if (!perf->available()) {
+            std::fprintf(stderr, "Hardware counters unavailable; reporting timing only\n");
+            perf.reset();
+        }
+    }
+    json events = json::array();
+    for (int e = 0; perf && e < PerfCounters::EVENT_COUNT; e++) {
+        const auto event = static_cast<PerfCounters::Event>(e);
+        if (perf->has(event)) events.push_back(PerfCounters::name(event));
+    }
+
+    json report = {
+        {"suite", "Ludo_Benchmark"},
+        {"schema", 2}, // 2: ns_per_op.p99 from short batches (p99_batch_ops), null when threaded
+        {"compiler", __VERSION__},
+#ifdef NDEBUG
+        {"assertions", false},
+#else
+        {"assertions", true},
+#endif
+        {"samples", opt.samples},
+        {"warmup", opt.warmup},
+        {"sample_ms", opt.sampleMs},
+        {"seed", opt.seed},
+        {"counters", events},
+        {"alloc_tracking", AllocTracker::enabled},
+        {"scenarios", json::array()}
+    };
+
+    std::fprintf(stderr, "%-22s %-10s %8s %8s %8s %10s %14s %6s %8s %8s %9s\n", "Scenario", "Op", "ns med",
+                 "ns p99", "ns min", "cyc med", "ops/s", "IPC", "brmiss", "L1Dmiss", "allocs");
+    for (const Scenario& sc : makeScenarios(opt)) {
+        if (!opt.filter.empty() && sc.name.find(opt.filter) == std::string::npos) continue;
+        report["scenarios"].push_back(measure(opt, sc, perf.get()));
+    }
+
+    std::ofstream out(opt.out);
+    out << report.dump(2) << "\n";
+    std::fprintf(stderr, "Wrote %s\n", opt.out.c_str());
+    return out ? 0 : 1;
 }
@@ -0,0 +1,59 @@
+#include <cstdio>
+#include "Game.h"
+#include "Random.h"
+
+// Plays random seeded games through the Game interface and checks the undo rules: the
+// mover can take a move back until the next roll, nobody else can, and no move can be
+// taken back once a roll has drawn from the dice stream.
+namespace {
+    constexpr int GAMES = 50;
+    constexpr int MAX_STEPS = 5000;
+
+    int failures = 0;
+
+    void expect(bool ok, const char* what, int players, int game, int step) {
+        if (ok) return;
+        if (failures++ < 10) std::printf("FAIL %s: %d players, game %d, step %d\n", what, players, game, step);
+    }
+
+    void playGames(int players, uint64_t seed) {
+        Ludo::Xoshiro256ss rng(seed);
+        for (int game = 0; game < GAMES; game++) {
+            std::shared_ptr<Game> g = Game::create(players, seed * GAMES + game);
+            for (int8_t seat = 0; seat < players; seat++) g->addPlayer(Player(seat, "P", "#000", true));
+            expect(g->undoLastMove(0) == -2, "undo before any move", players, game, 0);
+
+            for (int step = 0; step < MAX_STEPS && g->getGameStateEnum() != Game::State::GAME_OVER; step++) {
+                const int8_t mover = g->getCurrentPlayer();
+                if (g->getGameStateEnum() == Game::State::WAITING_FOR_ROLL) {
+                    g->rollDiceForPlayer(mover);
+                    // Whatever the roll did, the move before it is now out of reach
+                    for (int8_t seat = 0; seat < players; seat++) {
+                        expect(g->undoLastMove(seat) == -2, "undo after a roll", players, game, step);
+                    }
+                    continue;
+                }
+
+                const Ludo::MoveList moves = g->getLegalMoves();
+                const int8_t piece = moves[Ludo::uniformBelow(rng, moves.size())].piece;
+                const Ludo::GameState before = g->snapshot();
+                g->makeMoveForPlayer(mover, piece);
+
+                const int8_t other = static_cast<int8_t>((mover + 1) % players);
+                expect(g->undoLastMove(other) == -1, "undo by another player", players, game, step);
+                expect(g->undoLastMove(mover) == piece, "undo by the mover", players, game, step);
+                const Ludo::GameState after = g->snapshot();
+                expect(after.hash == before.hash && after.roll == before.roll && after.phase == before.phase,
+                       "position after undo", players, game, step);
+                expect(g->undoLastMove(mover) == -2, "second undo", players, game, step);
+                g->makeMoveForPlayer(mover, piece);
+            }
+        }
+    }
+}
+
+int main() {
+    for (int players = 2; players <= Ludo::MAX_PLAYERS; players++) playGames(players, players);
+    std::printf("%s: %d failures\n", failures ? "FAILED" : "OK", failures);
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,76 @@
+#include <cstdio>
+#include "GameState.h"
+#include "MoveGen.h"
+#include "Random.h"
+
+using namespace Ludo;
+
+// Plays random games through the rule functions and checks the incremental Zobrist key
+// against a full recompute after every roll, move and undo. Every legal move is also
+// made and unmade before the game goes on, which must restore the position exactly.
+// Positions that differ only in seat count must not share a key either.
+namespace {
+    constexpr int GAMES = 200;
+    constexpr int MAX_STEPS = 5000;
+
+    int failures = 0;
+
+    template <Position S>
+    bool samePosition(const S& a, const S& b) {
+        return a.hash == b.hash && a.progress == b.progress && a.currentPlayer == b.currentPlayer &&
+               a.roll == b.roll && a.phase == b.phase && a.winner == b.winner;
+    }
+
+    template <Position S>
+    void expect(bool ok, const char* what, const S& state, int game, int step) {
+        if (ok) return;
+        if (failures++ < 10) std::printf("FAIL %s: %d players, game %d, step %d\n", what, int(state.numPlayers), game, step);
+    }
+
+    template <Position S>
+    void playGames(S (*fresh)(), uint64_t seed) {
+        Xoshiro256ss rng(seed);
+        for (int game = 0; game < GAMES; game++) {
+            S state = fresh();
+            expect(state.hash == computeHash(state), "fresh hash", state, game, 0);
+            for (int step = 0; step < MAX_STEPS && !isTerminal(state); step++) {
+                if (state.phase == Phase::WAITING_FOR_ROLL) {
+                    applyRoll(state, rollDie(rng));
+                    expect(state.hash == computeHash(state), "hash after roll", state, game, step);
+                    continue;
+                }
+                MoveList moves;
+                generateMoves(state, state.roll, moves);
+                for (const Move& m : moves) {
+                    const S before = state;
+                    const UndoRecord undo = applyMove(state, m.piece);
+                    expect(state.hash == computeHash(state), "hash after move", state, game, step);
+                    undoMove(state, undo);
+                    expect(samePosition(state, before), "position after undo", state, game, step);
+                }
+                applyMove(state, moves[uniformBelow(rng, moves.size())].piece);
+                expect(state.hash == computeHash(state), "hash after move", state, game, step);
+            }
+        }
+    }
+
+    template <int Players>
+    GameState freshWide() { return makeGameState(Players); }
+}
+
+int main() {
+    for (int8_t a = 2; a <= MAX_PLAYERS; a++) {
+        for (int8_t b = a + 1; b <= MAX_PLAYERS; b++) {
+            GameState x = makeGameState(a), y = makeGameState(b);
+            expect(x.hash != y.hash, "seat count in hash", x, 0, 0);
+        }
+    }
+    playGames<GameState>(freshWide<2>, 2);
+    playGames<GameState>(freshWide<3>, 3);
+    playGames<GameState>(freshWide<4>, 4);
+    playGames<FixedGameState<2>>(makeFixedGameState<2>, 12);
+    playGames<FixedGameState<3>>(makeFixedGameState<3>, 13);
+    playGames<FixedGameState<4>>(makeFixedGameState<4>, 14);
+    std::printf("%s: %d failures\n", failures ? "FAILED" : "OK", failures);
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,197 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include "Expectimax.h"
+#include "GameState.h"
+#include "Mcts.h"
+#include "MoveGen.h"
+#include "Random.h"
+#include "ThreadPool.h"
+
+using namespace Ludo;
+
+// Search engine checks, one suite per argument ("expectimax", "mcts"; both by default).
+// expectimax: values against an unpruned brute-force search of the same tree, then a
+// depth-limited bot against a random mover. mcts: an iteration-capped bot against a random
+// mover, then tree- and root-parallel searches on a pool. Depths and iteration counts are
+// fixed and the budget is unbounded, so single-threaded runs replay exactly.
+namespace {
+    constexpr auto NO_DEADLINE = std::chrono::hours(1);
+    constexpr int POSITIONS = 60;
+    constexpr int MATCH_GAMES = 40;
+    constexpr int MATCH_MIN_WINS = 34;
+    constexpr uint64_t MCTS_ITERATIONS = 200;
+    constexpr int MCTS_MATCH_MIN_WINS = 28;
+    constexpr float TOLERANCE = 1e-4f;
+
+    int failures = 0;
+
+    // Same tree as Expectimax: paranoid values for `root`, a pass counts as a ply
+    float bruteChance(const GameState& state, int depth, int8_t root);
+
+    float bruteAfterMove(GameState state, int8_t piece, int depth, int8_t root) {
+        applyMove(state, piece);
+        if (isTerminal(state)) return state.winner == root ? Expectimax::WIN : Expectimax::LOSS;
+        return bruteChance(state, depth - 1, root);
+    }
+
+    float bruteDecision(const GameState& state, int depth, int8_t root) {
+        MoveList moves;
+        generateMoves(state, state.roll, moves);
+        const bool maximizing = state.currentPlayer == root;
+        float best = maximizing ? Expectimax::LOSS : Expectimax::WIN;
+        for (const Move& m : moves) {
+            const float v = bruteAfterMove(state, m.piece, depth, root);
+            best = maximizing ? std::max(best, v) : std::min(best, v);
+        }
+        return best;
+    }
+
+    float bruteChance(const GameState& state, int depth, int8_t root) {
+        if (depth <= 0) return Expectimax::evaluate(state, root);
+        float sum = 0.0f;
+        for (int8_t face = 1; face <= DIE_FACES; face++) {
+            GameState child = state;
+            applyRoll(child, face);
+            sum += child.phase == Phase::WAITING_FOR_MOVE ? bruteDecision(child, depth, root)
+                                                          : bruteChance(child, depth - 1, root);
+        }
+        return sum / DIE_FACES;
+    }
+
+    // Play one random move (or roll) from `state`
+    void randomStep(GameState& state, Xoshiro256ss& rng) {
+        if (state.phase == Phase::WAITING_FOR_ROLL) {
+            applyRoll(state, rollDie(rng));
+            return;
+        }
+        MoveList moves;
+        generateMoves(state, state.roll, moves);
+        applyMove(state, moves[uniformBelow(rng, moves.size())].piece);
+    }
+
+    // Positions with a real choice to make, from random play
+    void checkAgainstBruteForce(int players, uint64_t seed) {
+        Xoshiro256ss rng(seed);
+        GameState state = makeGameState(static_cast<int8_t>(players));
+        int checked = 0;
+        while (checked < POSITIONS) {
+            if (isTerminal(state)) state = makeGameState(static_cast<int8_t>(players));
+            randomStep(state, rng);
+            if (state.phase != Phase::WAITING_FOR_MOVE) continue;
+            MoveList moves;
+            generateMoves(state, state.roll, moves);
+            if (moves.size() < 2) continue;
+
+            const int depth = 1 + checked % 3;
+            float expected = Expectimax::LOSS;
+            for (const Move& m : moves) {
+                expected = std::max(expected, bruteAfterMove(state, m.piece, depth, state.currentPlayer));
+            }
+            TranspositionTable table(1);
+            Expectimax search(table);
+            const Expectimax::Result result = search.search(state, NO_DEADLINE, depth);
+            if (result.depth != depth || std::abs(result.value - expected) > TOLERANCE) {
+                if (failures++ < 10) {
+                    std::printf("FAIL brute force: %d players, depth %d, search %f (depth %d), expected %f\n",
+                                players, depth, result.value, result.depth, expected);
+                }
+            }
+            checked++;
+        }
+    }
+
+    // Two-player games of `bot` against a random mover, alternating who starts
+    template <class ChooseMove>
+    void checkBeatsRandom(const char* name, ChooseMove bot, int minWins, uint64_t seed) {
+        Xoshiro256ss rng(seed);
+        int wins = 0;
+        for (int game = 0; game < MATCH_GAMES; game++) {
+            const int8_t seat = static_cast<int8_t>(game % 2);
+            GameState state = makeGameState(2);
+            while (!isTerminal(state)) {
+                if (state.phase == Phase::WAITING_FOR_MOVE && state.currentPlayer == seat) {
+                    applyMove(state, bot(state).piece);
+                } else {
+                    randomStep(state, rng);
+                }
+            }
+            wins += state.winner == seat;
+        }
+        std::printf("%s won %d of %d games against random\n", name, wins, MATCH_GAMES);
+        if (wins < minWins) {
+            failures++;
+            std::printf("FAIL match: expected at least %d wins\n", minWins);
+        }
+    }
+
+    void checkExpectimax() {
+        for (int players = 2; players <= MAX_PLAYERS; players++) checkAgainstBruteForce(players, 100 + players);
+        TranspositionTable table(16);
+        Expectimax search(table);
+        checkBeatsRandom("Depth-2 expectimax", [&](const GameState& state) {
+            return search.search(state, NO_DEADLINE, 2).move;
+        }, MATCH_MIN_WINS, 7);
+    }
+
+    bool isLegal(const GameState& state, const Move& move) {
+        MoveList moves;
+        generateMoves(state, state.roll, moves);
+        for (const Move& m : moves) {
+            if (m.piece == move.piece) return true;
+        }
+        return false;
+    }
+
+    void checkMcts() {
+        Mcts::Config config;
+        config.arenaMB = 16;
+        config.maxIterations = MCTS_ITERATIONS;
+        config.maxPlayoutMoves = 20; // Short playouts, then the heuristic: faster and less noisy
+        config.seed = 11;
+        Mcts single(config);
+        checkBeatsRandom("MCTS (200 iterations)", [&](const GameState& state) {
+            return single.search(state, NO_DEADLINE).move;
+        }, MCTS_MATCH_MIN_WINS, 9);
+
+        // Both parallel modes on a pool: every thread runs its iterations, and the
+        // merged root statistics give a legal move
+        ThreadPool pool(2);
+        for (Mcts::Parallelism mode : {Mcts::Parallelism::TREE, Mcts::Parallelism::ROOT}) {
+            const char* name = mode == Mcts::Parallelism::TREE ? "tree" : "root";
+            Mcts::Config parallel = config;
+            parallel.threads = 2;
+            parallel.mode = mode;
+            Mcts search(pool, parallel);
+            Xoshiro256ss rng(21);
+            GameState state = makeGameState(4);
+            for (int checked = 0; checked < 20;) {
+                if (isTerminal(state)) state = makeGameState(4);
+                randomStep(state, rng);
+                if (state.phase != Phase::WAITING_FOR_MOVE) continue;
+                MoveList moves;
+                generateMoves(state, state.roll, moves);
+                if (moves.size() < 2) continue;
+                const Mcts::Result result = search.search(state, NO_DEADLINE);
+                if (!isLegal(state, result.move) || result.iterations != parallel.threads * MCTS_ITERATIONS) {
+                    if (failures++ < 10) {
+                        std::printf("FAIL %s-parallel MCTS: piece %d, %llu iterations\n", name, result.move.piece,
+                                    (unsigned long long)result.iterations);
+                    }
+                }
+                checked++;
+            }
+            std::printf("%s-parallel MCTS: 20 searches checked\n", name);
+        }
+    }
+}
+
+int main(int argc, char** argv) {
+    const bool all = argc < 2;
+    if (all || std::strcmp(argv[1], "expectimax") == 0) checkExpectimax();
+    if (all || std::strcmp(argv[1], "mcts") == 0) checkMcts();
+    std::printf("%s: %d failures\n", failures ? "FAILED" : "OK", failures);
+    return failures ? 1 : 0;
+}
@@ -1,15 +1,55 @@
 #include "libs/httplib.h"
+#include "AllocTracker.h"
+#include "EventLog.h"
+#include "GameFeed.h"
 #include "GameManager.h"
+#include "Computer.h"
+#include "Metrics.h"
 #include "libs/json.hpp" 
+#include <algorithm>
+#include <atomic>
 #include <iostream>
 #include <fstream>
+#include <cstdlib>
+#include <map>
+#include <mutex>
 #include <sstream>
+#include <string_view>
 
 using namespace httplib;
 using json = nlohmann::json;
 
-// Global Game Manager
-GameManager gameManager;
+// Global Game Manager; LUDO_SEED=<n> makes every game's dice reproducible
+GameManager makeGameManager() {
+    const char* seed = std::getenv("LUDO_SEED");
+    return seed ? GameManager(std::stoull(seed)) : GameManager();
+}
+GameManager gameManager = makeGameManager();
+
+// Abandoned sessions are evicted after LUDO_IDLE_TTL seconds without a request (default
+// 30 min) and finished games after LUDO_FINISHED_TTL (default 5 min); 0 keeps them
+EvictionPolicy makeEvictionPolicy() {
+    auto seconds = [](const char* name, int fallback) {
+        const char* value = std::getenv(name);
+        return std::chrono::seconds(value ? std::stoll(value) : fallback);
+    };
+    return {seconds("LUDO_IDLE_TTL", 30 * 60), seconds("LUDO_FINISHED_TTL", 5 * 60)};
+}
+
+// Default thinking time for server-side bot turns, and the range a client may ask for:
+// a search holds a worker thread, so requests outside it are refused
+constexpr int BOT_BUDGET_US = 500;
+constexpr int64_t BOT_BUDGET_MIN_US = 50;
+constexpr int64_t BOT_BUDGET_MAX_US = 2 * BOT_BUDGET_US;
+
+// State pushes for /events subscribers. An idle stream sends a comment line this often so
+// proxies keep it open and a vanished game is noticed.
+GameFeed gameFeed;
+constexpr auto SSE_KEEPALIVE = std::chrono::milliseconds(15000);
+// Each open event stream holds a worker until the client leaves, so streams are capped
+// well below the worker count and the rest of the API stays served; set in main()
+size_t sseStreamLimit = 0;
+std::atomic<size_t> sseStreams{0};
 
 std::string readFile(const std::string& path) {
     std::ifstream f(path);
@@ -26,14 +66,187 @@ std::string readFile(const std::string& path) {
     return buffer.str();
 }
 
+// Heap allocations per request type, filled only in -DLUDO_ALLOC_TRACKING=ON builds.
+// Handlers run on httplib's worker threads, so each request is measured with that
+// thread's own counters between the pre- and post-routing hooks.
+struct RouteAllocations {
+    uint64_t requests = 0;
+    AllocTracker::Counts heap;
+};
+
+std::mutex allocStatsMutex;
+std::map<std::string, RouteAllocations> allocStats;
+thread_local AllocTracker::Counts requestStart;
+
+// Collapse game ids so every game shares one key per action; unknown paths share "other"
+std::string routeKey(const Request& req) {
+    static const std::string gamePrefix = "/api/v1/game/";
+    const std::string& path = req.path;
+    if (path.rfind(gamePrefix, 0) == 0 && path != gamePrefix + "create") {
+        size_t slash = path.find('/', gamePrefix.size());
+        if (slash != std::string::npos) return req.method + " " + gamePrefix + ":id" + path.substr(slash);
+    }
+    if (path == "/" || path == "/style.css" || path == "/script.js" || path == "/metrics" ||
+        path.rfind("/api/", 0) == 0) {
+        return req.method + " " + path;
+    }
+    return "other";
+}
+
+void recordAllocations(const std::string& key) {
+    const AllocTracker::Counts used = AllocTracker::thread() - requestStart;
+    std::lock_guard<std::mutex> lock(allocStatsMutex);
+    RouteAllocations& route = allocStats[key];
+    route.requests++;
+    route.heap.allocations += used.allocations;
+    route.heap.frees += used.frees;
+    route.heap.bytes += used.bytes;
+}
+
+// Request count and handler latency per route for /metrics. The map is filled with every
+// known route before the server starts and only read afterwards, so lookups need no lock.
+struct RouteMetrics {
+    Metrics::Counter requests;
+    Metrics::Histogram latency;
+};
+
+const char* const ROUTES[] = {
+    "GET /", "GET /style.css", "GET /script.js", "GET /metrics",
+    "POST /api/v1/game/create", "GET /api/v1/game/:id/state", "POST /api/v1/game/:id/roll",
+    "POST /api/v1/game/:id/move", "POST /api/v1/game/:id/reset", "POST /api/v1/game/:id/bot",
+    "POST /api/v1/game/:id/undo", "GET /api/v1/game/:id/events", "GET /api/v1/debug/allocations", "GET /api/v1/debug/games", "other"
+};
+
+std::map<std::string, RouteMetrics> routeMetrics;
+thread_local std::chrono::steady_clock::time_point requestBegin;
+Metrics::Histogram jsonSerialize; // Building and dumping the /state document
+
+RouteMetrics& routeMetricsFor(const std::string& key) {
+    auto it = routeMetrics.find(key);
+    return it != routeMetrics.end() ? it->second : routeMetrics.find("other")->second;
+}
+
+std::string renderMetrics() {
+    Metrics::Writer w;
+    auto labels = [](const std::string& key) {
+        const size_t space = key.find(' ');
+        if (space == std::string::npos) return "method=\"ANY\",route=\"" + key + "\"";
+        return "method=\"" + key.substr(0, space) + "\",route=\"" + key.substr(space + 1) + "\"";
+    };
+
+    w.header("ludo_http_requests_total", "HTTP requests handled, by route.", "counter");
+    for (const auto& [key, route] : routeMetrics) {
+        w.sample("ludo_http_requests_total", labels(key), double(route.requests.value()));
+    }
+    w.header("ludo_http_request_duration_seconds", "Time spent in routing and the handler, by route.", "histogram");
+    for (const auto& [key, route] : routeMetrics) {
+        w.histogram("ludo_http_request_duration_seconds", labels(key), route.latency);
+    }
+
+    const GameManager::Stats games = gameManager.stats();
+    w.header("ludo_games_active", "Games currently registered.", "gauge");
+    w.sample("ludo_games_active", "", double(games.active));
+    w.header("ludo_games_created_total", "Games created since start-up.", "counter");
+    w.sample("ludo_games_created_total", "", double(games.created));
+    w.header("ludo_games_evicted_total", "Games removed by idle or finished-game eviction.", "counter");
+    w.sample("ludo_games_evicted_total", "", double(games.evicted));
+    w.header("ludo_games_pooled", "Spare game objects ready for reuse.", "gauge");
+    w.sample("ludo_games_pooled", "", double(gameManager.pooledGames()));
+
+    Metrics::Engine& engine = Metrics::engine();
+    w.header("ludo_moves_total", "Moves applied; rate() gives moves per second.", "counter");
+    w.sample("ludo_moves_total", "", double(engine.moves.value()));
+    w.header("ludo_captures_total", "Pieces sent back to base.", "counter");
+    w.sample("ludo_captures_total", "", double(engine.captures.value()));
+    w.header("ludo_game_lock_wait_seconds", "Wait to acquire a game's mutex.", "histogram");
+    w.histogram("ludo_game_lock_wait_seconds", "", engine.gameLockWait);
+    w.header("ludo_manager_lock_wait_seconds", "Wait to acquire a GameManager shard lock.", "histogram");
+    w.histogram("ludo_manager_lock_wait_seconds", "", engine.managerLockWait);
+    w.header("ludo_json_serialize_seconds", "Building and serializing the game state JSON.", "histogram");
+    w.histogram("ludo_json_serialize_seconds", "", jsonSerialize);
+    w.header("ludo_event_log_dropped_total", "Game events dropped because a log ring was full.", "counter");
+    w.sample("ludo_event_log_dropped_total", "", double(EventLog::dropped()));
+    return w.text();
+}
+
+// True if an If-None-Match header lists `etag` (weak "W/" forms match too) or is "*"
+bool etagMatches(const std::string& ifNoneMatch, const std::string& etag) {
+    size_t pos = 0;
+    while (pos < ifNoneMatch.size()) {
+        size_t end = ifNoneMatch.find(',', pos);
+        if (end == std::string::npos) end = ifNoneMatch.size();
+        size_t first = ifNoneMatch.find_first_not_of(" \t", pos);
+        size_t last = ifNoneMatch.find_last_not_of(" \t", end - 1);
+        if (first != std::string::npos && first < end && last >= first) {
+            std::string_view tag(ifNoneMatch.data() + first, last - first + 1);
+            if (tag.starts_with("W/")) tag.remove_prefix(2);
+            if (tag == "*" || tag == etag) return true;
+        }
+        pos = end + 1;
+    }
+    return false;
+}
+
 void add_cors_headers(Response& res) {
     res.set_header("Access-Control-Allow-Origin", "*");
     res.set_header("Access-Control-Allow-Methods", "POST, GET, OPTIONS");
-    res.set_header("Access-Control-Allow-Headers", "Content-Type");
+    res.set_header("Access-Control-Allow-Headers", "Content-Type, If-None-Match");
+    res.set_header("Access-Control-Expose-Headers", "ETag");
+}
+
+// Game events (captures, finishes, wins) go to LUDO_EVENT_LOG: a file path, "-" for stdout
+// (the default) or "off"; LUDO_EVENT_FORMAT=binary writes raw records instead of JSON lines
+void startEventLog() {
+    const char* path = std::getenv("LUDO_EVENT_LOG");
+    const char* format = std::getenv("LUDO_EVENT_FORMAT");
+    const bool binary = format && std::string(format) == "binary";
+    std::FILE* out = stdout;
+    if (path && std::string(path) == "off") return;
+    if (path && std::string(path) != "-") {
+        out = std::fopen(path, binary ? "ab" : "a");
+        if (!out) {
+            std::cerr << "Cannot open event log " << path << std::endl;
+            return;
+        }
+    }
+    EventLog::start(out, binary ? EventLog::Format::BINARY : EventLog::Format::JSON_LINES);
 }
 
 int main() {
     Server svr;
+    // Every open event stream holds a worker, so size the pool for them (LUDO_HTTP_THREADS, default 64)
+    const char* httpThreads = std::getenv("LUDO_HTTP_THREADS");
+    const size_t workers = httpThreads ? std::stoull(httpThreads) : 64;
+    svr.new_task_queue = [workers] { return new httplib::ThreadPool(workers); };
+    // At most LUDO_SSE_STREAMS event streams (default a quarter of the workers), always
+    // leaving at least half the workers for ordinary requests
+    const char* sseLimit = std::getenv("LUDO_SSE_STREAMS");
+    sseStreamLimit = std::min<size_t>(sseLimit ? std::stoull(sseLimit) : workers / 4, workers / 2);
+    startEventLog();
+    gameManager.startEviction(makeEvictionPolicy());
+    // Ready-made 4-player games so create requests never build one (LUDO_WARM_GAMES, default 64)
+    const char* warmGames = std::getenv("LUDO_WARM_GAMES");
+    gameManager.warmPool(warmGames ? std::stoull(warmGames) : 64);
+
+    for (const char* route : ROUTES) routeMetrics[route];
+    svr.set_pre_routing_handler([](const Request&, Response&) {
+        requestBegin = std::chrono::steady_clock::now();
+        if (AllocTracker::enabled) requestStart = AllocTracker::thread();
+        return Server::HandlerResponse::Unhandled;
+    });
+    svr.set_post_routing_handler([](const Request& req, Response&) {
+        const auto elapsed = std::chrono::steady_clock::now() - requestBegin;
+        const std::string key = routeKey(req);
+        if (AllocTracker::enabled) recordAllocations(key);
+        RouteMetrics& route = routeMetricsFor(key);
+        route.requests.add();
+        route.latency.observe(elapsed);
+    });
+
+    // Prometheus scrape endpoint
+    svr.Get("/metrics", [](const Request&, Response& res) {
+        res.set_content(renderMetrics(), "text/plain; version=0.0.4");
+    });
 
     // Serve Static Files
     svr.Get("/", [](const Request& req, Response& res) {
@@ -54,11 +267,25 @@ int main() {
     // API V1: Create Game
     svr.Post("/api/v1/game/create", [](const Request& req, Response& res) {
         add_cors_headers(res);
-        std::string gameId = gameManager.createGame();
+        // Optional body {"players": 2-4}; defaults to 4
+        int players = 4;
+        if (!req.body.empty()) {
+            auto j = json::parse(req.body, nullptr, false);
+            if (!j.is_discarded() && j.contains("players") && j["players"].is_number_integer()) {
+                players = j["players"];
+            }
+        }
+        GameId gameId = gameManager.createGame(players);
+        if (gameId == GameManager::NO_GAME) {
+            res.status = 400;
+            json response = {{"status", "error"}, {"message", "players must be 2, 3 or 4"}};
+            res.set_content(response.dump(), "application/json");
+            return;
+        }
         
         json response;
         response["status"] = "success";
-        response["data"] = { {"gameId", gameId} };
+        response["data"] = { {"gameId", GameManager::formatId(gameId)} };
         res.set_content(response.dump(), "application/json");
     });
 
@@ -66,8 +293,7 @@ int main() {
     // URL: /api/v1/game/:gameId/state
     svr.Get(R"(/api/v1/game/([^/]+)/state)", [](const Request& req, Response& res) {
         add_cors_headers(res);
-        std::string gameId = req.matches[1];
-        auto game = gameManager.getGame(gameId);
+        auto game = gameManager.getGame(GameManager::parseId(req.matches[1].str()));
         
         if (!game) {
             res.status = 404;
@@ -76,18 +302,88 @@ int main() {
             return;
         }
 
-        json j = game->getGameState();
+        // The version is read lock-free, before the state, so an unchanged board is answered
+        // without serializing and a served body is never older than its tag
+        const std::string etag = "\"" + std::to_string(game->version()) + "\"";
+        res.set_header("ETag", etag);
+        res.set_header("Cache-Control", "no-cache");
+        if (req.has_header("If-None-Match") && etagMatches(req.get_header_value("If-None-Match"), etag)) {
+            res.status = 304;
+            return;
+        }
+
+        const auto t0 = std::chrono::steady_clock::now();
         json response;
         response["status"] = "success";
-        response["data"] = j;
-        res.set_content(response.dump(), "application/json");
+        response["data"] = game->getGameState();
+        std::string body = response.dump();
+        jsonSerialize.observe(std::chrono::steady_clock::now() - t0);
+        res.set_content(std::move(body), "application/json");
+    });
+
+    // API V1: State Events (server-sent events)
+    // URL: /api/v1/game/:gameId/events
+    // Sends the current state at once, then again after every change; "gone" when the game is removed
+    svr.Get(R"(/api/v1/game/([^/]+)/events)", [](const Request& req, Response& res) {
+        add_cors_headers(res);
+        const GameId gameId = GameManager::parseId(req.matches[1].str());
+        if (!gameManager.getGame(gameId)) {
+            res.status = 404;
+            json response = {{"status", "error"}, {"message", "Game not found"}};
+            res.set_content(response.dump(), "application/json");
+            return;
+        }
+
+        if (sseStreams.fetch_add(1, std::memory_order_relaxed) >= sseStreamLimit) {
+            sseStreams.fetch_sub(1, std::memory_order_relaxed);
+            res.status = 503;
+            json response = {{"status", "error"}, {"message", "Too many event streams; poll /state instead"}};
+            res.set_content(response.dump(), "application/json");
+            return;
+        }
+
+        res.set_header("Cache-Control", "no-cache");
+        auto channel = gameFeed.subscribe(gameId);
+        auto seen = std::make_shared<uint64_t>(0);
+        res.set_chunked_content_provider("text/event-stream",
+            [gameId, channel, seen](size_t, DataSink& sink) {
+                const bool changed = *seen == 0 || GameFeed::wait(*channel, *seen, SSE_KEEPALIVE);
+                // getGame also counts as activity, so a watched game is not evicted as idle
+                auto game = gameManager.getGame(gameId);
+                if (!game) {
+                    sink.write("event: gone\ndata: {}\n\n", 22);
+                    sink.done();
+                    return true;
+                }
+                if (!changed) return sink.write(": keepalive\n\n", 13);
+
+                // One serialization per change, however many subscribers are watching
+                std::string frame = "event: state\ndata: ";
+                {
+                    std::lock_guard<std::mutex> lock(channel->mutex);
+                    if (channel->payloadSequence != channel->sequence) {
+                        const auto t0 = std::chrono::steady_clock::now();
+                        channel->payload = game->getGameState().dump();
+                        jsonSerialize.observe(std::chrono::steady_clock::now() - t0);
+                        channel->payloadSequence = channel->sequence;
+                    }
+                    frame += channel->payload;
+                    *seen = channel->payloadSequence;
+                }
+                frame += "\n\n";
+                return sink.write(frame.data(), frame.size());
+            },
+            [gameId, channel](bool) {
+                gameFeed.unsubscribe(gameId, channel);
+                sseStreams.fetch_sub(1, std::memory_order_relaxed);
+            });
     });
 
     // API V1: Roll Dice
     // URL: /api/v1/game/:gameId/roll
     svr.Post(R"(/api/v1/game/([^/]+)/roll)", [](const Request& req, Response& res) {
         add_cors_headers(res);
-        std::string gameId = req.matches[1];
+        const GameId gameId = GameManager::parseId(req.matches[1].str());
         auto game = gameManager.getGame(gameId);
         
         if (!game) {
@@ -112,6 +408,7 @@ int main() {
             } else {
                 response["status"] = "success";
                 response["data"] = { {"roll", roll} };
+                gameFeed.publish(gameId);
             }
             res.set_content(response.dump(), "application/json");
         } catch (...) {
@@ -123,7 +420,7 @@ int main() {
     // URL: /api/v1/game/:gameId/move
     svr.Post(R"(/api/v1/game/([^/]+)/move)", [](const Request& req, Response& res) {
         add_cors_headers(res);
-        std::string gameId = req.matches[1];
+        const GameId gameId = GameManager::parseId(req.matches[1].str());
         auto game = gameManager.getGame(gameId);
         
         if (!game) {
@@ -143,6 +440,7 @@ int main() {
             if (success) {
                  response["status"] = "success";
                  response["data"] = { {"moved", true} };
+                 gameFeed.publish(gameId);
             } else {
                  response["status"] = "error";
                  response["message"] = "Invalid move";
@@ -156,7 +454,7 @@ int main() {
     // API V1: Reset
     svr.Post(R"(/api/v1/game/([^/]+)/reset)", [](const Request& req, Response& res) {
         add_cors_headers(res);
-        std::string gameId = req.matches[1];
+        const GameId gameId = GameManager::parseId(req.matches[1].str());
         auto game = gameManager.getGame(gameId);
         
         if (!game) {
@@ -167,9 +465,133 @@ int main() {
         }
         
         game->resetGame();
+        gameFeed.publish(gameId);
         res.set_content("{\"status\":\"success\"}", "application/json");
     });
 
+    // API V1: Bot Turn
+    // Rolls for the player and lets the expectimax bot pick the move
+    svr.Post(R"(/api/v1/game/([^/]+)/bot)", [](const Request& req, Response& res) {
+        add_cors_headers(res);
+        const GameId gameId = GameManager::parseId(req.matches[1].str());
+        auto game = gameManager.getGame(gameId);
+        
+        if (!game) {
+            res.status = 404;
+            json response = {{"status", "error"}, {"message", "Game not found"}};
+            res.set_content(response.dump(), "application/json");
+            return;
+        }
+
+        try {
+            auto j = json::parse(req.body);
+            int pId = j["playerId"];
+            int64_t budgetUs = j.value("budgetUs", int64_t(BOT_BUDGET_US));
+            if (budgetUs < BOT_BUDGET_MIN_US || budgetUs > BOT_BUDGET_MAX_US) {
+                res.status = 400;
+                json response = {{"status", "error"}, {"message", "budgetUs must be between " +
+                    std::to_string(BOT_BUDGET_MIN_US) + " and " + std::to_string(BOT_BUDGET_MAX_US)}};
+                res.set_content(response.dump(), "application/json");
+                return;
+            }
+            int roll = game->rollDiceForPlayer(pId);
+            
+            json response;
+            if (roll == -1) {
+                response["status"] = "error";
+                response["message"] = "Not your turn";
+            } else {
+                int piece = -1;
+                Ludo::GameState position = game->snapshot();
+                if (position.phase == Game::State::WAITING_FOR_MOVE && position.currentPlayer == pId) {
+                    Ludo::Move move = Computer::chooseMove(position, roll, std::chrono::microseconds(budgetUs));
+                    if (move.piece >= 0 && game->makeMoveForPlayer(pId, move.piece)) piece = move.piece;
+                }
+                response["status"] = "success";
+                response["data"] = { {"roll", roll}, {"piece", piece} };
+                gameFeed.publish(gameId);
+            }
+            res.set_content(response.dump(), "application/json");
+        } catch (...) {
+            res.status = 400;
+        }
+    });
+
+    // API V1: Undo last move
+    svr.Post(R"(/api/v1/game/([^/]+)/undo)", [](const Request& req, Response& res) {
+        add_cors_headers(res);
+        const GameId gameId = GameManager::parseId(req.matches[1].str());
+        auto game = gameManager.getGame(gameId);
+        
+        if (!game) {
+             res.status = 404;
+             json response = {{"status", "error"}, {"message", "Game not found"}};
+             res.set_content(response.dump(), "application/json");
+             return;
+        }
+        
+        try {
+            auto j = json::parse(req.body);
+            int pId = j["playerId"];
+            int piece = game->undoLastMove(pId);
+
+            json response;
+            if (piece == -1) {
+                response["status"] = "error";
+                response["message"] = "Last move was not yours";
+            } else if (piece == -2) {
+                response["status"] = "error";
+                response["message"] = "Nothing to undo";
+            } else {
+                response["status"] = "success";
+                response["data"] = { {"undone", true}, {"piece", piece} };
+                gameFeed.publish(gameId);
+            }
+            res.set_content(response.dump(), "application/json");
+        } catch (...) {
+            res.status = 400;
+        }
+    });
+
+    // Debug: game registry counters
+    svr.Get("/api/v1/debug/games", [](const Request&, Response& res) {
+        add_cors_headers(res);
+        const GameManager::Stats stats = gameManager.stats();
+        json response;
+        response["status"] = "success";
+        response["data"] = {{"active", stats.active}, {"created", stats.created}, {"evicted", stats.evicted},
+                            {"pooled", gameManager.pooledGames()}};
+        res.set_content(response.dump(), "application/json");
+    });
+
+    // Debug: heap allocations per request type since start-up
+    svr.Get("/api/v1/debug/allocations", [](const Request&, Response& res) {
+        add_cors_headers(res);
+        const AllocTracker::Counts total = AllocTracker::process();
+        json routes = json::object();
+        {
+            std::lock_guard<std::mutex> lock(allocStatsMutex);
+            for (const auto& [key, route] : allocStats) {
+                routes[key] = {
+                    {"requests", route.requests},
+                    {"allocations", route.heap.allocations},
+                    {"frees", route.heap.frees},
+                    {"bytes", route.heap.bytes},
+                    {"allocations_per_request", double(route.heap.allocations) / route.requests},
+                    {"bytes_per_request", double(route.heap.bytes) / route.requests}
+                };
+            }
+        }
+        json response;
+        response["status"] = "success";
+        response["data"] = {
+            {"enabled", AllocTracker::enabled},
+            {"process", {{"allocations", total.allocations}, {"frees", total.frees}, {"bytes", total.bytes}}},
+            {"routes", routes}
+        };
+        res.set_content(response.dump(), "application/json");
+    });
+
     // Preflight handler
     svr.Options(R"(/api/.*)", [](const Request&, Response& res) {
         add_cors_headers(res);
@@ -0,0 +1,318 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "BatchEngine.h"
+#include "GameState.h"
+#include "MoveGen.h"
+#include "Policy.h"
+#include "Random.h"
+#include "ThreadPool.h"
+
+using namespace Ludo;
+
+namespace {
+    constexpr int MAX_GAME_STEPS = 20000; // Rolls + moves before a game is abandoned
+    constexpr int HISTOGRAM_BUCKET = 50;  // Moves per histogram row
+
+    struct Options {
+        uint64_t games = 100000;
+        int threads = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+        int players = 4;
+        std::vector<std::string> seats;
+        uint64_t seed = 1;
+        uint64_t chunk = 4096; // Games per task
+        int batch = 0;         // SIMD lanes per task (16/32/64); 0 = scalar engine with policies
+        uint64_t checkSteps = 0; // Differential check of the batch engine, in steps
+    };
+
+    struct Totals {
+        uint64_t games = 0;
+        uint64_t unfinished = 0;
+        uint64_t moves = 0;
+        std::array<uint64_t, MAX_PLAYERS> wins{};
+        std::vector<uint64_t> lengths; // lengths[m] = games that took m moves
+
+        void merge(const Totals& other) {
+            games += other.games;
+            unfinished += other.unfinished;
+            moves += other.moves;
+            for (int i = 0; i < MAX_PLAYERS; i++) wins[i] += other.wins[i];
+            if (lengths.size() < other.lengths.size()) lengths.resize(other.lengths.size());
+            for (size_t i = 0; i < other.lengths.size(); i++) lengths[i] += other.lengths[i];
+        }
+    };
+
+    void usage() {
+        std::cerr << "Usage: Ludo_Simulate [--games N] [--threads T] [--players 2-4]\n"
+                     "                     [--seats random,greedy,first,expectimax:100,mcts:1000,...]\n"
+                     "                     [--seed S] [--chunk GAMES_PER_TASK]\n"
+                     "                     [--batch 16|32|64] [--check-batch STEPS]\n";
+    }
+
+    bool parseArgs(int argc, char** argv, Options& opt) {
+        for (int i = 1; i < argc; i++) {
+            std::string arg = argv[i];
+            if (i + 1 >= argc) return false;
+            std::string value = argv[++i];
+            try {
+                if (arg == "--games") opt.games = std::stoull(value);
+                else if (arg == "--threads") opt.threads = std::stoi(value);
+                else if (arg == "--players") opt.players = std::stoi(value);
+                else if (arg == "--seed") opt.seed = std::stoull(value);
+                else if (arg == "--chunk") opt.chunk = std::max<uint64_t>(1, std::stoull(value));
+                else if (arg == "--batch") opt.batch = std::stoi(value);
+                else if (arg == "--check-batch") opt.checkSteps = std::stoull(value);
+                else if (arg == "--seats") {
+                    std::stringstream ss(value);
+                    std::string seat;
+                    while (std::getline(ss, seat, ',')) opt.seats.push_back(seat);
+                } else return false;
+            } catch (...) {
+                return false;
+            }
+        }
+        if (opt.players < 2 || opt.players > MAX_PLAYERS || opt.threads < 1) return false;
+        if (opt.batch != 0 && opt.batch != 16 && opt.batch != 32 && opt.batch != 64) return false;
+        if (opt.batch && !opt.seats.empty()) return false; // The batch engine has its own policy
+        if (opt.seats.empty()) opt.seats.assign(opt.players, opt.batch ? "batch" : "random");
+        if (opt.seats.size() == 1) opt.seats.assign(opt.players, opt.seats[0]);
+        return static_cast<int>(opt.seats.size()) == opt.players;
+    }
+
+    void record(Totals& totals, int moves, int8_t winner) {
+        totals.games++;
+        totals.moves += moves;
+        if (winner >= 0) totals.wins[winner]++;
+        else totals.unfinished++;
+        if (totals.lengths.size() <= static_cast<size_t>(moves)) totals.lengths.resize(moves + 1);
+        totals.lengths[moves]++;
+    }
+
+    // Play one complete game; returns the number of moves made
+    int playGame(const Options& opt, std::vector<std::unique_ptr<Policy>>& seats,
+                 Xoshiro256ss& rng, Totals& totals) {
+        GameState state = makeGameState(static_cast<int8_t>(opt.players));
+        int moves = 0;
+        for (int step = 0; step < MAX_GAME_STEPS && !isTerminal(state); step++) {
+            if (state.phase == Phase::WAITING_FOR_ROLL) {
+                applyRoll(state, rollDie(rng));
+                continue;
+            }
+            MoveList legal;
+            generateMoves(state, state.roll, legal);
+            Move m = seats[state.currentPlayer]->choose(state, legal, rng());
+            applyMove(state, m.piece);
+            moves++;
+        }
+
+        record(totals, moves, state.winner);
+        return moves;
+    }
+
+    // Play `games` games on the SIMD engine, refilling lanes as games finish. Once `games`
+    // have started no lane is refilled, and every started game is played out and recorded:
+    // stopping at the first `games` to finish would drop the longest ones.
+    template <int LANES>
+    void playBatch(const Options& opt, uint64_t seed, uint64_t games, Totals& totals) {
+        BatchEngine<LANES> engine(static_cast<int8_t>(opt.players), seed);
+        std::array<int, LANES> steps{};
+        std::array<bool, LANES> active{};
+        uint64_t started = 0, done = 0;
+        for (int l = 0; l < LANES && started < games; l++, started++) active[l] = true;
+        while (done < started) {
+            engine.step();
+            for (int l = 0; l < LANES; l++) {
+                if (!active[l] || (!engine.finished(l) && ++steps[l] < MAX_GAME_STEPS)) continue;
+                record(totals, engine.moves(l), engine.winner(l));
+                done++;
+                steps[l] = 0;
+                if (started < games) {
+                    engine.resetLane(l);
+                    started++;
+                } else {
+                    active[l] = false;
+                }
+            }
+        }
+    }
+
+    // Run the batch engine and scalar GameState rules side by side on identical dice and
+    // compare every lane after every step. Returns the number of mismatches.
+    template <int LANES>
+    uint64_t checkBatch(const Options& opt) {
+        const int8_t players = static_cast<int8_t>(opt.players);
+        BatchEngine<LANES> engine(players, opt.seed);
+        std::array<GameState, LANES> reference;
+        reference.fill(makeGameState(players));
+
+        uint64_t mismatches = 0, moves = 0;
+        alignas(64) int8_t rolls[LANES];
+        alignas(64) uint8_t choices[LANES], masks[LANES];
+        for (uint64_t step = 0; step < opt.checkSteps && mismatches < 10; step++) {
+            engine.rollDice(rolls, choices);
+            engine.legalMoves(rolls, masks);
+            moves += engine.step(rolls, choices);
+            for (int l = 0; l < LANES; l++) {
+                GameState& ref = reference[l];
+                if (isTerminal(ref)) continue;
+                uint8_t expectedMask = 0;
+                for (int8_t i = 0; i < MAX_PIECES; i++) {
+                    if (canMovePiece(ref.progress[ref.currentPlayer][i], rolls[l])) expectedMask |= 1 << i;
+                }
+                applyRoll(ref, rolls[l]);
+                for (int k = 0; k < MAX_PIECES && ref.phase == Phase::WAITING_FOR_MOVE; k++) {
+                    const int8_t piece = static_cast<int8_t>((choices[l] + k) & (MAX_PIECES - 1));
+                    if (isLegalMove(ref, piece)) applyMove(ref, piece);
+                }
+
+                const GameState got = engine.lane(l);
+                if (got.hash != ref.hash || got.progress != ref.progress || got.currentPlayer != ref.currentPlayer ||
+                    got.roll != ref.roll || got.phase != ref.phase || got.winner != ref.winner ||
+                    masks[l] != expectedMask) {
+                    std::printf("Mismatch at step %llu lane %d (roll %d, choice %d)\n",
+                                (unsigned long long)step, l, rolls[l], choices[l]);
+                    mismatches++;
+                }
+                if (isTerminal(ref)) {
+                    ref = makeGameState(players);
+                    engine.resetLane(l);
+                }
+            }
+        }
+        std::printf("Batch check: %d lanes (%s), %llu steps, %llu moves, %llu mismatches\n", LANES,
+                    BatchEngine<LANES>::isa(), (unsigned long long)opt.checkSteps, (unsigned long long)moves,
+                    (unsigned long long)mismatches);
+        return mismatches;
+    }
+
+    template <class F>
+    auto withLanes(int lanes, F f) {
+        if (lanes == 16) return f(std::integral_constant<int, 16>{});
+        if (lanes == 64) return f(std::integral_constant<int, 64>{});
+        return f(std::integral_constant<int, 32>{});
+    }
+
+    // Wilson score interval, 95%
+    void wilson(uint64_t wins, uint64_t n, double& lo, double& hi) {
+        if (n == 0) { lo = hi = 0; return; }
+        const double z = 1.96;
+        const double p = double(wins) / n;
+        const double denom = 1 + z * z / n;
+        const double center = (p + z * z / (2.0 * n)) / denom;
+        const double half = z * std::sqrt(p * (1 - p) / n + z * z / (4.0 * n * n)) / denom;
+        lo = center - half;
+        hi = center + half;
+    }
+
+    uint64_t percentile(const std::vector<uint64_t>& lengths, uint64_t total, double q) {
+        uint64_t target = static_cast<uint64_t>(std::ceil(q * total));
+        uint64_t seen = 0;
+        for (size_t m = 0; m < lengths.size(); m++) {
+            seen += lengths[m];
+            if (seen >= std::max<uint64_t>(1, target)) return m;
+        }
+        return lengths.empty() ? 0 : lengths.size() - 1;
+    }
+
+    void report(const Options& opt, const Totals& t, double seconds) {
+        std::printf("Ludo_Simulate: %llu games, %d players, %d threads, seed %llu\n",
+                    (unsigned long long)t.games, opt.players, opt.threads, (unsigned long long)opt.seed);
+        if (opt.batch) {
+            std::printf("Batch engine: %d lanes (%s), rotating random policy\n", opt.batch,
+                        withLanes(opt.batch, [](auto lanes) { return BatchEngine<lanes()>::isa(); }));
+        }
+        std::printf("Elapsed %.3f s | %.0f games/s | %.0f moves/s\n\n",
+                    seconds, t.games / seconds, t.moves / seconds);
+
+        std::printf("%-5s %-16s %12s %9s   %s\n", "Seat", "Policy", "Wins", "Win rate", "95% CI");
+        for (int s = 0; s < opt.players; s++) {
+            double lo, hi;
+            wilson(t.wins[s], t.games, lo, hi);
+            std::printf("%-5d %-16s %12llu %8.3f%%   [%.3f%%, %.3f%%]\n", s, opt.seats[s].c_str(),
+                        (unsigned long long)t.wins[s], 100.0 * t.wins[s] / std::max<uint64_t>(1, t.games),
+                        100.0 * lo, 100.0 * hi);
+        }
+        if (t.unfinished) {
+            std::printf("Unfinished after %d steps: %llu\n", MAX_GAME_STEPS, (unsigned long long)t.unfinished);
+        }
+
+        uint64_t minLen = 0, maxLen = 0;
+        for (size_t m = 0; m < t.lengths.size(); m++) if (t.lengths[m]) { minLen = m; break; }
+        for (size_t m = t.lengths.size(); m-- > 0;) if (t.lengths[m]) { maxLen = m; break; }
+        std::printf("\nGame length (moves): mean %.1f | min %llu | p10 %llu | p50 %llu | p90 %llu | p99 %llu | max %llu\n",
+                    double(t.moves) / std::max<uint64_t>(1, t.games), (unsigned long long)minLen,
+                    (unsigned long long)percentile(t.lengths, t.games, 0.10),
+                    (unsigned long long)percentile(t.lengths, t.games, 0.50),
+                    (unsigned long long)percentile(t.lengths, t.games, 0.90),
+                    (unsigned long long)percentile(t.lengths, t.games, 0.99), (unsigned long long)maxLen);
+
+        std::vector<uint64_t> buckets(t.lengths.size() / HISTOGRAM_BUCKET + 1);
+        for (size_t m = 0; m < t.lengths.size(); m++) buckets[m / HISTOGRAM_BUCKET] += t.lengths[m];
+        const uint64_t peak = *std::max_element(buckets.begin(), buckets.end());
+        for (size_t b = 0; b < buckets.size(); b++) {
+            if (!buckets[b]) continue;
+            int bar = peak ? static_cast<int>(50 * buckets[b] / peak) : 0;
+            std::printf("%5zu-%-5zu %10llu %s\n", b * HISTOGRAM_BUCKET, (b + 1) * HISTOGRAM_BUCKET - 1,
+                        (unsigned long long)buckets[b], std::string(bar, '#').c_str());
+        }
+    }
+}
+
+int main(int argc, char** argv) {
+    Options opt;
+    if (!parseArgs(argc, argv, opt)) {
+        usage();
+        return 1;
+    }
+    if (opt.checkSteps) {
+        return withLanes(opt.batch, [&](auto lanes) { return checkBatch<lanes()>(opt); }) ? 1 : 0;
+    }
+    for (const auto& seat : opt.seats) {
+        if (!opt.batch && !makePolicy(seat)) {
+            std::cerr << "Unknown policy: " << seat << "\n";
+            return 1;
+        }
+    }
+
+    // Per-worker policies and totals; only the owning worker touches them
+    std::vector<std::vector<std::unique_ptr<Policy>>> policies(opt.threads);
+    std::vector<Totals> workerTotals(opt.threads);
+    for (auto& seats : policies) {
+        if (opt.batch) continue; // The batch engine plays its own fixed policy
+        for (const auto& spec : opt.seats) seats.push_back(makePolicy(spec));
+    }
+
+    ThreadPool pool(opt.threads);
+    const auto start = std::chrono::steady_clock::now();
+    const uint64_t chunks = (opt.games + opt.chunk - 1) / opt.chunk;
+    // One non-overlapping RNG stream per chunk (2^128 draws apart): results do not depend
+    // on which worker ran it
+    Xoshiro256ss stream(opt.seed);
+    for (uint64_t c = 0; c < chunks; c++, stream.jump()) {
+        pool.submit([&, c, rng = stream]() mutable {
+            const int w = ThreadPool::currentWorker();
+            const uint64_t end = std::min(opt.games, (c + 1) * opt.chunk);
+            if (opt.batch) {
+                withLanes(opt.batch, [&](auto lanes) {
+                    playBatch<lanes()>(opt, rng(), end - c * opt.chunk, workerTotals[w]);
+                });
+                return;
+            }
+            for (uint64_t g = c * opt.chunk; g < end; g++) playGame(opt, policies[w], rng, workerTotals[w]);
+        });
+    }
+    pool.wait();
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    Totals totals;
+    for (const auto& t : workerTotals) totals.merge(t);
+    report(opt, totals, seconds);
+    return 0;
+}
@@ -104,7 +104,40 @@ async function createGame() {
     const json = await res.json();
     gameId = json.data.gameId;
     addLog(`Engine ready. Session: ${gameId}`);
+    subscribe();
+}
+
+// Server pushes the state after every change; poll where EventSource is missing or the
+// server refuses the stream (503 once too many are open)
+let events = null;
+function poll() {
     updateState();
+    setInterval(updateState, 2000);
+}
+
+function subscribe() {
+    if (!window.EventSource) {
+        poll();
+        return;
+    }
+    events = new EventSource(`/api/v1/game/${gameId}/events`);
+    events.addEventListener('state', (e) => renderGame(JSON.parse(e.data)));
+    // A refused stream is CLOSED; a dropped one is CONNECTING and retried by the browser
+    events.addEventListener('error', () => {
+        if (!events || events.readyState !== EventSource.CLOSED) return;
+        events = null;
+        poll();
+    });
+    events.addEventListener('gone', () => {
+        events.close();
+        events = null;
+        addLog('Session expired. Reload to start a new game.');
+    });
+}
+
+// After our own action: the stream already carries the new state
+function refresh() {
+    if (!events) updateState();
 }
 
 async function updateState() {
@@ -133,6 +166,9 @@ function renderGame(data) {
     // Remove old pieces
     document.querySelectorAll('.piece').forEach(p => p.remove());
 
+    // Pieces the engine will accept a move for, with their flags
+    const legalMoves = new Map((data.legal_moves || []).map(m => [m.piece, m]));
+
     // Render Pieces
     data.players.forEach((player, pIdx) => {
         player.pieces.forEach((piece, pcIdx) => {
@@ -140,10 +176,9 @@ function renderGame(data) {
             el.className = `piece p${pIdx}`;
 
             // If movable, add class and listener
-            if (currentState === 2 && pIdx === currentPlayerIdx) {
-                // Simplified movable check: if it's our turn and we rolled
-                // In a real app, we'd check backend hasPossibleMoves
+            if (currentState === 2 && pIdx === currentPlayerIdx && legalMoves.has(pcIdx)) {
                 el.classList.add('movable');
+                if (legalMoves.get(pcIdx).capture) el.title = 'Captures';
                 el.onclick = () => makeMove(pcIdx);
             }
 
@@ -187,7 +222,7 @@ async function rollDice() {
             UI.dice.classList.remove('rolling');
             if (json.status === 'success') {
                 addLog(`Player ${currentPlayerIdx} rolled a ${json.data.roll}`);
-                updateState();
+                refresh();
             } else {
                 addLog(`Roll failed: ${json.message}`);
                 UI.rollBtn.disabled = false;
@@ -206,7 +241,7 @@ async function makeMove(pieceId) {
     });
     const json = await res.json();
     if (json.status === 'success') {
-        updateState();
+        refresh();
     } else {
         addLog(`Invalid move: ${json.message}`);
     }
@@ -219,11 +254,8 @@ function getHexColor(idx) {
 UI.rollBtn.onclick = rollDice;
 UI.resetBtn.onclick = async () => {
     await fetch(`/api/v1/game/${gameId}/reset`, { method: 'POST' });
-    updateState();
+    refresh();
 };
 
 createBoard();
 createGame();
-
-// Poll state occasionally for multiplayer synchronized feel
-setInterval(updateState, 2000);